@@ -74,3 +74,17 @@ Mat<double> eigen_sym_(const doubles_matrix<>& x) {
 
   return out;
 }
+
+// Native R complex vectors and matrices
+
+[[cpp11::register]] SEXP eigen_gen_complexes(const doubles_matrix<>& x) {
+  Mat<double> X = as_Mat(x);
+  Col<std::complex<double>> y = eig_gen(X);
+  return as_complexes(y);
+}
+
+[[cpp11::register]] SEXP complexes_matrix_conj(SEXP x) {
+  Mat<std::complex<double>> X = as_cx_mat(x);
+  Mat<std::complex<double>> y = conj(X);
+  return as_complexes_matrix(y);
+}
@@ -120,3 +120,78 @@
 
   return res;
 }
+
+[[cpp11::register]] doubles typedef_Cube_double(const doubles& x) {
+  Cube<double> y = as_Cube(x);
+  return as_doubles_array(y);
+}
+
+[[cpp11::register]] integers typedef_Cube_int(const integers& x) {
+  Cube<int> y = as_Cube(x);
+  return as_integers_array(y);
+}
+
+[[cpp11::register]] doubles typedef_uvec_index(const doubles& x, const integers& idx) {
+  // R indices are 1-based, Armadillo indices are 0-based
+  Col<double> y = as_Col(x);
+  uvec i = as_uvec_index(idx);
+  Col<double> z = y.elem(i);
+  return as_doubles(z);
+}
+
+[[cpp11::register]] integers typedef_sort_index(const doubles& x) {
+  Col<double> y = as_Col(x);
+  uvec i = sort_index(y);
+  return as_integers_index(i);
+}
+
+[[cpp11::init]] void init_altrep_classes(DllInfo* dll) {
+  init_altrep(dll, "cpp11armadillotest");
+}
+
+[[cpp11::register]] doubles typedef_Col_altrep(const doubles& x) {
+  Col<double> y = as_Col(x);
+  Col<double> z = 2 * y;
+  return as_doubles_altrep(std::move(z));
+}
+
+[[cpp11::register]] doubles_matrix<> typedef_Mat_altrep(const doubles_matrix<>& x) {
+  Mat<double> y = as_Mat(x);
+  return as_doubles_matrix_altrep(y.t());
+}
+
+[[cpp11::register]] doubles_matrix<> typedef_data_frame(const data_frame& x) {
+  Mat<double> y = as_Mat(x);
+  return as_doubles_matrix(y);
+}
+
+[[cpp11::register]] doubles_matrix<> typedef_data_frame_cols(const data_frame& x,
+                                                             const integers& cols) {
+  fmat y = as_fmat(x, cols);
+  return as_doubles_matrix(y);
+}
+
+[[cpp11::register]] int typedef_uword_size() { return static_cast<int>(sizeof(uword)); }
+
+[[cpp11::register]] integers_matrix<> typedef_umat_to_integers(const integers_matrix<>& x) {
+  umat y = as_umat(x);
+  return as_integers_matrix(y);
+}
+
+[[cpp11::register]] integers typedef_long_long_to_integers(const doubles& x) {
+  // values outside of the int range become NA
+  Col<long long> y = conv_to<Col<long long>>::from(as_Col(x));
+  return as_integers(y);
+}
+
+[[cpp11::register]] integers typedef_memory_alignment(const int& n) {
+  mat A(n, n, fill::ones);
+  mat B = A * 2.0 + A;
+
+  writable::integers res(
+      {static_cast<int>(reinterpret_cast<std::uintptr_t>(B.memptr()) % 64),
+       static_cast<int>(memory::is_aligned(B.memptr())),
+       static_cast<int>(accu(B) == 3.0 * n * n)});
+
+  return res;
+}
@@ -7,3 +7,68 @@
   PutRNGstate();  // Ensure R's RNG state is synchronized
   return as_integers_matrix(y);
 }
+
+[[cpp11::register]] doubles_matrix<> random_normal_nxm(const int& n, const int& m) {
+  GetRNGstate();
+  arma::Mat<double> y(n, m);
+  ::arma_rng::randn<double>::fill(y.memptr(), y.n_elem);
+  PutRNGstate();
+  return as_doubles_matrix(y);
+}
+
+[[cpp11::register]] doubles random_uniform_n(const int& n, const double& a,
+                                            const double& b) {
+  GetRNGstate();
+  arma::Col<double> y(n);
+  ::arma_rng::randu<double>::fill(y.memptr(), y.n_elem, a, b);
+  PutRNGstate();
+  return as_doubles(y);
+}
+
+[[cpp11::register]] integers random_integers_n(const int& n, const int& a, const int& b) {
+  GetRNGstate();
+  arma::Col<int> y(n);
+  ::arma_rng::randi<int>::fill(y.memptr(), y.n_elem, a, b);
+  PutRNGstate();
+  return as_integers(y);
+}
+
+[[cpp11::register]] integers random_permutation_n(const int& n) {
+  GetRNGstate();
+  uvec y = ::arma_rng::randperm(n);
+  PutRNGstate();
+  return as_integers(y);
+}
+
+[[cpp11::register]] doubles random_gamma_n(const int& n, const double& a, const double& b) {
+  GetRNGstate();
+  arma::Col<double> y(n);
+  ::arma_rng::randg<double>::fill(y.memptr(), y.n_elem, a, b);
+  PutRNGstate();
+  return as_doubles(y);
+}
+
+[[cpp11::register]] doubles_matrix<> random_mvn(const int& n, const doubles& mu,
+                                                const doubles_matrix<>& sigma) {
+  MvnGenerator<double> generator(as_Col(mu), as_Mat(sigma));
+
+  GetRNGstate();
+  mat X = generator.draw(n);
+  PutRNGstate();
+
+  return as_doubles_matrix(X);
+}
+
+[[cpp11::register]] doubles_matrix<> random_wishart_mean(const int& n,
+                                                         const doubles_matrix<>& s,
+                                                         const double& df) {
+  WishartGenerator<double> generator(as_Mat(s), df);
+
+  GetRNGstate();
+  cube W = generator.draw(n);
+  PutRNGstate();
+
+  mat M = mean(W, 2);
+
+  return as_doubles_matrix(M);
+}
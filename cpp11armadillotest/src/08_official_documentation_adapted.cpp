@@ -3269,3 +3269,21 @@
 
   return as_doubles(X);
 }
+
+[[cpp11::register]] list kmeans_interrupt_(const int& n, const int& d) {
+  mat data(d, n, fill::randu);
+
+  mat means;
+
+  // same as pressing Ctrl+C before the first iteration
+  RInterrupt::request();
+
+  bool status = kmeans(means, data, 2, random_subset, 10, false);
+
+  writable::list res(2);
+
+  res[0] = writable::logicals({status});
+  res[1] = as_doubles_matrix(means);
+
+  return res;
+}
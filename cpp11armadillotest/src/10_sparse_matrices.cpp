@@ -12,6 +12,13 @@
   return as_dgCMatrix(A);
 }
 
+[[cpp11::register]] SEXP test_dgCMatrix_to_SpMat_trusted(SEXP x) {
+  // Skip the validation of the slots, the input comes from the Matrix package
+  SpMat<double> A = as_SpMat(x, true);
+
+  return as_dgCMatrix(A);
+}
+
 // [[cpp11::register]] SEXP sum_matrices_(SEXP x) {
 //   // Convert from dgCMatrix to SpMat
 //   SpMat<double> A = as_SpMat(x);
@@ -27,3 +34,52 @@
 //   // Convert back to dgCMatrix and return
 //   return as_dgCMatrix(A);
 // }
+
+[[cpp11::register]] doubles_matrix<> test_dense_to_SpMat_tol(const doubles_matrix<>& x,
+                                                              const double tol) {
+  // Drop the entries with an absolute value smaller than or equal to tol
+  SpMat<double> A = as_SpMat(x, tol);
+
+  return as_doubles_matrix(A);
+}
+
+[[cpp11::register]] SEXP test_dgCMatrix_to_sp_fmat(SEXP x) {
+  // Narrow the values to float while filling the CSC arrays
+  SpMat<float> A = as_sp_fmat(x);
+
+  return as_dgCMatrix(A);
+}
+
+[[cpp11::register]] SEXP test_dense_to_sp_fmat(const doubles_matrix<>& x) {
+  // Values that are zero once narrowed to float are not stored
+  SpMat<float> A = as_sp_fmat(x);
+
+  return as_dgCMatrix(A);
+}
+
+[[cpp11::register]] SEXP test_sparse_Matrix_to_SpMat(SEXP x, const bool expand_symmetric) {
+  // Any dgT, dgR, dsC, dtC, lgC, ngC, ... object is converted without coercion in R
+  SpMat<double> A = as_SpMat(x, false, expand_symmetric);
+
+  return as_dgCMatrix(A);
+}
+
+[[cpp11::register]] SEXP test_SpMat_to_sparse_Matrix(SEXP x, const std::string& cls) {
+  SpMat<double> A = as_SpMat(x);
+
+  if (cls == "dgTMatrix") {
+    return as_dgTMatrix(A);
+  } else if (cls == "dgRMatrix") {
+    return as_dgRMatrix(A);
+  } else if (cls == "dsCMatrix") {
+    return as_dsCMatrix(A, 'L');
+  } else if (cls == "dtCMatrix") {
+    return as_dtCMatrix(A);
+  } else if (cls == "lgCMatrix") {
+    return as_lgCMatrix(A);
+  } else if (cls == "ngCMatrix") {
+    return as_ngCMatrix(A);
+  }
+
+  return as_dgCMatrix(A);
+}
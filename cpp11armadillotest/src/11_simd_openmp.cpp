@@ -0,0 +1,194 @@
+#include "00_main.h"
+
+[[cpp11::register]] list elementwise_simd_(const doubles& x, const int& level) {
+  vec X = as_Col(x);
+
+  // kernels of the given instruction set, 0 is the baseline
+  const int previous = Simd::level();
+  Simd::set_level(level);
+
+  vec Y = 2.0 * X + X;
+  vec Z = X % X + X;
+  uvec L = X < 0.5;
+
+  writable::list out;
+
+  out.push_back({"exp"_nm = as_doubles(exp(X))});
+  out.push_back({"log"_nm = as_doubles(log(X))});
+  out.push_back({"sqrt"_nm = as_doubles(sqrt(X))});
+  out.push_back({"abs"_nm = as_doubles(abs(X - 0.5))});
+  out.push_back({"times_plus"_nm = as_doubles(Y)});
+  out.push_back({"schur_plus"_nm = as_doubles(Z)});
+  out.push_back({"lt"_nm = as_integers(L)});
+
+  Simd::set_level(previous);
+
+  return out;
+}
+
+[[cpp11::register]] list elementwise_math_(const doubles& x, const int& level,
+                                           const int& accuracy) {
+  vec X = as_Col(x);
+  vec A = abs(X);
+
+  // 0 uses the C library (strict), 1 the SIMD approximations (fast)
+  const int previous_level = Simd::level();
+  const int previous_accuracy = Simd::accuracy();
+  Simd::set_level(level);
+  Simd::set_accuracy(accuracy);
+
+  writable::list out;
+
+  out.push_back({"exp2"_nm = as_doubles(exp2(X))});
+  out.push_back({"exp10"_nm = as_doubles(exp10(X))});
+  out.push_back({"log2"_nm = as_doubles(log2(A))});
+  out.push_back({"log10"_nm = as_doubles(log10(A))});
+  out.push_back({"sin"_nm = as_doubles(sin(X))});
+  out.push_back({"cos"_nm = as_doubles(cos(X))});
+  out.push_back({"tanh"_nm = as_doubles(tanh(X))});
+  out.push_back({"erf"_nm = as_doubles(erf(X))});
+  out.push_back({"erfc"_nm = as_doubles(erfc(X))});
+  out.push_back({"normpdf"_nm = as_doubles(normpdf(X, 1.0, 2.0))});
+  out.push_back({"log_normpdf"_nm = as_doubles(log_normpdf(X, 1.0, 2.0))});
+  out.push_back({"normcdf"_nm = as_doubles(normcdf(X, 1.0, 2.0))});
+
+  Simd::set_level(previous_level);
+  Simd::set_accuracy(previous_accuracy);
+
+  return out;
+}
+
+[[cpp11::register]] list openmp_thresholds_(const doubles& x, const doubles& thresholds) {
+  vec X = as_Col(x);
+
+  writable::list out;
+
+  out.push_back({"set"_nm = Parallel::set_thresholds(thresholds)});
+  out.push_back({"plus"_nm = as_doubles(X + X)});
+  out.push_back({"exp"_nm = as_doubles(exp(X) + X)});
+  out.push_back({"pow"_nm = as_doubles(pow(X, 1.5))});
+
+  Parallel::calibrate(true);
+  out.push_back({"calibrated"_nm = Parallel::thresholds()});
+
+  // back to the defaults, and to an uncalibrated state, for the next tests
+  Parallel::reset_thresholds();
+  out.push_back({"reset"_nm = Parallel::thresholds()});
+  out.push_back({"is_calibrated"_nm = writable::logicals({Parallel::calibrated()})});
+
+  return out;
+}
+
+[[cpp11::register]] list openmp_threads_(const doubles& x, const int& n) {
+  vec X = as_Col(x);
+
+  writable::list out;
+
+  {
+    // at most n threads until the end of the block
+    ParallelThreads scope(n);
+
+    out.push_back({"budget"_nm = Parallel::threads()});
+    out.push_back({"max_threads"_nm = Parallel::max_threads()});
+    out.push_back({"exp"_nm = as_doubles(exp(X) + X)});
+  }
+
+  out.push_back({"after"_nm = Parallel::threads()});
+
+  return out;
+}
+
+[[cpp11::register]] doubles nested_tasks_(const doubles& x, const int& n, const bool& tasks) {
+  vec X = as_Col(x);
+  vec out(n, fill::zeros);
+
+  // Armadillo operations inside the loop run as OpenMP tasks when tasks is true
+  const bool previous = Parallel::set_tasks(tasks);
+
+#pragma omp parallel for schedule(static)
+  for (int r = 0; r < n; ++r) {
+    vec Y = exp(X / (r + 1.0)) + X;
+    out[r] = accu(tan(Y / (10.0 + Y)));
+  }
+
+  Parallel::set_tasks(previous);
+
+  return as_doubles(out);
+}
+
+[[cpp11::register]] list elementwise_integer_(const integers& x, const integers& y) {
+  // integer element types keep the scalar loops
+  uvec X = as_uvec(x);
+  uvec Y = as_uvec(y);
+  umat A = join_rows(X, Y);
+  Col<int> Z = as_Col(x);
+
+  uvec plus = X + Y;
+  uvec times = X * 2;
+  uvec schur = X % Y;
+  uvec schur_plus = X % Y + X;
+  umat twice = A + A;
+  Col<int> minus = Z - 3;
+
+  writable::list out;
+
+  out.push_back({"plus"_nm = as_integers(plus)});
+  out.push_back({"times"_nm = as_integers(times)});
+  out.push_back({"schur"_nm = as_integers(schur)});
+  out.push_back({"schur_plus"_nm = as_integers(schur_plus)});
+  out.push_back({"twice"_nm = as_integers(uvec(vectorise(twice)))});
+  out.push_back({"minus"_nm = as_integers(minus)});
+  out.push_back({"intersect"_nm = as_integers(uvec(intersect(X, Y)))});
+
+  return out;
+}
+
+[[cpp11::register]] logicals gmm_parallel_(const int& n, const int& d, const int& n_models,
+                                           const bool& interrupt) {
+  mat data(d, n, fill::randu);
+  std::vector<int> status(n_models);
+
+  // same as pressing Ctrl+C while the models are trained, the error cannot leave the
+  // parallel loop so learn() returns false and the check after the loop raises it
+  if (interrupt) {
+    RInterrupt::request();
+  }
+
+#pragma omp parallel for schedule(static)
+  for (int m = 0; m < n_models; ++m) {
+    gmm_diag model;
+    status[m] = model.learn(data, 2, maha_dist, random_subset, 10, 5, 1e-10, false);
+  }
+
+  RInterrupt::check();
+
+  writable::logicals out(n_models);
+
+  for (int m = 0; m < n_models; ++m) {
+    out[m] = (status[m] != 0);
+  }
+
+  return out;
+}
+
+[[cpp11::register]] bool kmeans_deadline_(const int& n, const int& d, const int& k,
+                                          const double& seconds, const bool& cancel) {
+  mat data(d, n, fill::randu);
+  mat means;
+  bool status;
+
+  {
+    // seconds = 0 runs without a time limit
+    RInterruptDeadline deadline(seconds);
+
+    status = kmeans(means, data, k, random_subset, 1000, false);
+
+    // a cancellation that is never reported, as from a kernel that stopped inside a
+    // parallel region, is cleared at the end of the scope too
+    if (cancel) {
+      RInterrupt::request();
+    }
+  }
+
+  return status;
+}
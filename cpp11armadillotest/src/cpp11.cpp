@@ -61,6 +61,20 @@ extern "C" SEXP _cpp11armadillotest_eigen_gen_no_wrapper(SEXP x) {
     return cpp11::as_sexp(eigen_gen_no_wrapper(cpp11::as_cpp<cpp11::decay_t<const doubles_matrix<>&>>(x)));
   END_CPP11
 }
+// 02_eigen.cpp
+SEXP eigen_gen_complexes(const doubles_matrix<>& x);
+extern "C" SEXP _cpp11armadillotest_eigen_gen_complexes(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(eigen_gen_complexes(cpp11::as_cpp<cpp11::decay_t<const doubles_matrix<>&>>(x)));
+  END_CPP11
+}
+// 02_eigen.cpp
+SEXP complexes_matrix_conj(SEXP x);
+extern "C" SEXP _cpp11armadillotest_complexes_matrix_conj(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(complexes_matrix_conj(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x)));
+  END_CPP11
+}
 // 03_chol.cpp
 doubles_matrix<> chol_mat(const doubles_matrix<>& x, std::string type);
 extern "C" SEXP _cpp11armadillotest_chol_mat(SEXP x, SEXP type) {
@@ -159,6 +173,90 @@ extern "C" SEXP _cpp11armadillotest_typedef_spmat_int_exchangeability(SEXP x) {
     return cpp11::as_sexp(typedef_spmat_int_exchangeability(cpp11::as_cpp<cpp11::decay_t<const integers_matrix<>&>>(x)));
   END_CPP11
 }
+// 06_typedefs.cpp
+doubles typedef_Cube_double(const doubles& x);
+extern "C" SEXP _cpp11armadillotest_typedef_Cube_double(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_Cube_double(cpp11::as_cpp<cpp11::decay_t<const doubles&>>(x)));
+  END_CPP11
+}
+// 06_typedefs.cpp
+integers typedef_Cube_int(const integers& x);
+extern "C" SEXP _cpp11armadillotest_typedef_Cube_int(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_Cube_int(cpp11::as_cpp<cpp11::decay_t<const integers&>>(x)));
+  END_CPP11
+}
+// 06_typedefs.cpp
+doubles typedef_uvec_index(const doubles& x, const integers& idx);
+extern "C" SEXP _cpp11armadillotest_typedef_uvec_index(SEXP x, SEXP idx) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_uvec_index(cpp11::as_cpp<cpp11::decay_t<const doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const integers&>>(idx)));
+  END_CPP11
+}
+// 06_typedefs.cpp
+integers typedef_sort_index(const doubles& x);
+extern "C" SEXP _cpp11armadillotest_typedef_sort_index(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_sort_index(cpp11::as_cpp<cpp11::decay_t<const doubles&>>(x)));
+  END_CPP11
+}
+// 06_typedefs.cpp
+doubles typedef_Col_altrep(const doubles& x);
+extern "C" SEXP _cpp11armadillotest_typedef_Col_altrep(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_Col_altrep(cpp11::as_cpp<cpp11::decay_t<const doubles&>>(x)));
+  END_CPP11
+}
+// 06_typedefs.cpp
+doubles_matrix<> typedef_Mat_altrep(const doubles_matrix<>& x);
+extern "C" SEXP _cpp11armadillotest_typedef_Mat_altrep(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_Mat_altrep(cpp11::as_cpp<cpp11::decay_t<const doubles_matrix<>&>>(x)));
+  END_CPP11
+}
+// 06_typedefs.cpp
+doubles_matrix<> typedef_data_frame(const data_frame& x);
+extern "C" SEXP _cpp11armadillotest_typedef_data_frame(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_data_frame(cpp11::as_cpp<cpp11::decay_t<const data_frame&>>(x)));
+  END_CPP11
+}
+// 06_typedefs.cpp
+doubles_matrix<> typedef_data_frame_cols(const data_frame& x, const integers& cols);
+extern "C" SEXP _cpp11armadillotest_typedef_data_frame_cols(SEXP x, SEXP cols) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_data_frame_cols(cpp11::as_cpp<cpp11::decay_t<const data_frame&>>(x), cpp11::as_cpp<cpp11::decay_t<const integers&>>(cols)));
+  END_CPP11
+}
+// 06_typedefs.cpp
+int typedef_uword_size();
+extern "C" SEXP _cpp11armadillotest_typedef_uword_size() {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_uword_size());
+  END_CPP11
+}
+// 06_typedefs.cpp
+integers_matrix<> typedef_umat_to_integers(const integers_matrix<>& x);
+extern "C" SEXP _cpp11armadillotest_typedef_umat_to_integers(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_umat_to_integers(cpp11::as_cpp<cpp11::decay_t<const integers_matrix<>&>>(x)));
+  END_CPP11
+}
+// 06_typedefs.cpp
+integers typedef_long_long_to_integers(const doubles& x);
+extern "C" SEXP _cpp11armadillotest_typedef_long_long_to_integers(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_long_long_to_integers(cpp11::as_cpp<cpp11::decay_t<const doubles&>>(x)));
+  END_CPP11
+}
+// 06_typedefs.cpp
+integers typedef_memory_alignment(const int& n);
+extern "C" SEXP _cpp11armadillotest_typedef_memory_alignment(SEXP n) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(typedef_memory_alignment(cpp11::as_cpp<cpp11::decay_t<const int&>>(n)));
+  END_CPP11
+}
 // 07_reproducibility.cpp
 integers_matrix<> random_matrix_nxn(const int& n);
 extern "C" SEXP _cpp11armadillotest_random_matrix_nxn(SEXP n) {
@@ -166,6 +264,55 @@ extern "C" SEXP _cpp11armadillotest_random_matrix_nxn(SEXP n) {
     return cpp11::as_sexp(random_matrix_nxn(cpp11::as_cpp<cpp11::decay_t<const int&>>(n)));
   END_CPP11
 }
+// 07_reproducibility.cpp
+doubles_matrix<> random_normal_nxm(const int& n, const int& m);
+extern "C" SEXP _cpp11armadillotest_random_normal_nxm(SEXP n, SEXP m) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(random_normal_nxm(cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<const int&>>(m)));
+  END_CPP11
+}
+// 07_reproducibility.cpp
+doubles random_uniform_n(const int& n, const double& a, const double& b);
+extern "C" SEXP _cpp11armadillotest_random_uniform_n(SEXP n, SEXP a, SEXP b) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(random_uniform_n(cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<const double&>>(a), cpp11::as_cpp<cpp11::decay_t<const double&>>(b)));
+  END_CPP11
+}
+// 07_reproducibility.cpp
+integers random_integers_n(const int& n, const int& a, const int& b);
+extern "C" SEXP _cpp11armadillotest_random_integers_n(SEXP n, SEXP a, SEXP b) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(random_integers_n(cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<const int&>>(a), cpp11::as_cpp<cpp11::decay_t<const int&>>(b)));
+  END_CPP11
+}
+// 07_reproducibility.cpp
+integers random_permutation_n(const int& n);
+extern "C" SEXP _cpp11armadillotest_random_permutation_n(SEXP n) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(random_permutation_n(cpp11::as_cpp<cpp11::decay_t<const int&>>(n)));
+  END_CPP11
+}
+// 07_reproducibility.cpp
+doubles random_gamma_n(const int& n, const double& a, const double& b);
+extern "C" SEXP _cpp11armadillotest_random_gamma_n(SEXP n, SEXP a, SEXP b) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(random_gamma_n(cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<const double&>>(a), cpp11::as_cpp<cpp11::decay_t<const double&>>(b)));
+  END_CPP11
+}
+// 07_reproducibility.cpp
+doubles_matrix<> random_mvn(const int& n, const doubles& mu, const doubles_matrix<>& sigma);
+extern "C" SEXP _cpp11armadillotest_random_mvn(SEXP n, SEXP mu, SEXP sigma) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(random_mvn(cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<const doubles&>>(mu), cpp11::as_cpp<cpp11::decay_t<const doubles_matrix<>&>>(sigma)));
+  END_CPP11
+}
+// 07_reproducibility.cpp
+doubles_matrix<> random_wishart_mean(const int& n, const doubles_matrix<>& s, const double& df);
+extern "C" SEXP _cpp11armadillotest_random_wishart_mean(SEXP n, SEXP s, SEXP df) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(random_wishart_mean(cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<const doubles_matrix<>&>>(s), cpp11::as_cpp<cpp11::decay_t<const double&>>(df)));
+  END_CPP11
+}
 // 08_official_documentation_adapted.cpp
 doubles_matrix<> matrix1_(const doubles_matrix<>& a);
 extern "C" SEXP _cpp11armadillotest_matrix1_(SEXP a) {
@@ -1755,6 +1902,13 @@ extern "C" SEXP _cpp11armadillotest_spsolve1_(SEXP a, SEXP b, SEXP method) {
     return cpp11::as_sexp(spsolve1_(cpp11::as_cpp<cpp11::decay_t<const doubles_matrix<>&>>(a), cpp11::as_cpp<cpp11::decay_t<const doubles&>>(b), cpp11::as_cpp<cpp11::decay_t<const char*>>(method)));
   END_CPP11
 }
+// 08_official_documentation_adapted.cpp
+list kmeans_interrupt_(const int& n, const int& d);
+extern "C" SEXP _cpp11armadillotest_kmeans_interrupt_(SEXP n, SEXP d) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(kmeans_interrupt_(cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<const int&>>(d)));
+  END_CPP11
+}
 // 09_regression.cpp
 doubles ols_(const doubles_matrix<>& x, const doubles& y);
 extern "C" SEXP _cpp11armadillotest_ols_(SEXP x, SEXP y) {
@@ -1776,6 +1930,104 @@ extern "C" SEXP _cpp11armadillotest_test_dgCMatrix_to_SpMat(SEXP x) {
     return cpp11::as_sexp(test_dgCMatrix_to_SpMat(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x)));
   END_CPP11
 }
+// 10_sparse_matrices.cpp
+SEXP test_dgCMatrix_to_SpMat_trusted(SEXP x);
+extern "C" SEXP _cpp11armadillotest_test_dgCMatrix_to_SpMat_trusted(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(test_dgCMatrix_to_SpMat_trusted(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x)));
+  END_CPP11
+}
+// 10_sparse_matrices.cpp
+doubles_matrix<> test_dense_to_SpMat_tol(const doubles_matrix<>& x, const double tol);
+extern "C" SEXP _cpp11armadillotest_test_dense_to_SpMat_tol(SEXP x, SEXP tol) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(test_dense_to_SpMat_tol(cpp11::as_cpp<cpp11::decay_t<const doubles_matrix<>&>>(x), cpp11::as_cpp<cpp11::decay_t<const double>>(tol)));
+  END_CPP11
+}
+// 10_sparse_matrices.cpp
+SEXP test_dgCMatrix_to_sp_fmat(SEXP x);
+extern "C" SEXP _cpp11armadillotest_test_dgCMatrix_to_sp_fmat(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(test_dgCMatrix_to_sp_fmat(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x)));
+  END_CPP11
+}
+// 10_sparse_matrices.cpp
+SEXP test_dense_to_sp_fmat(const doubles_matrix<>& x);
+extern "C" SEXP _cpp11armadillotest_test_dense_to_sp_fmat(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(test_dense_to_sp_fmat(cpp11::as_cpp<cpp11::decay_t<const doubles_matrix<>&>>(x)));
+  END_CPP11
+}
+// 10_sparse_matrices.cpp
+SEXP test_sparse_Matrix_to_SpMat(SEXP x, const bool expand_symmetric);
+extern "C" SEXP _cpp11armadillotest_test_sparse_Matrix_to_SpMat(SEXP x, SEXP expand_symmetric) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(test_sparse_Matrix_to_SpMat(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const bool>>(expand_symmetric)));
+  END_CPP11
+}
+// 10_sparse_matrices.cpp
+SEXP test_SpMat_to_sparse_Matrix(SEXP x, const std::string& cls);
+extern "C" SEXP _cpp11armadillotest_test_SpMat_to_sparse_Matrix(SEXP x, SEXP cls) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(test_SpMat_to_sparse_Matrix(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<const std::string&>>(cls)));
+  END_CPP11
+}
+// 11_simd_openmp.cpp
+list elementwise_simd_(const doubles& x, const int& level);
+extern "C" SEXP _cpp11armadillotest_elementwise_simd_(SEXP x, SEXP level) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(elementwise_simd_(cpp11::as_cpp<cpp11::decay_t<const doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const int&>>(level)));
+  END_CPP11
+}
+// 11_simd_openmp.cpp
+list elementwise_math_(const doubles& x, const int& level, const int& accuracy);
+extern "C" SEXP _cpp11armadillotest_elementwise_math_(SEXP x, SEXP level, SEXP accuracy) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(elementwise_math_(cpp11::as_cpp<cpp11::decay_t<const doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const int&>>(level), cpp11::as_cpp<cpp11::decay_t<const int&>>(accuracy)));
+  END_CPP11
+}
+// 11_simd_openmp.cpp
+list openmp_thresholds_(const doubles& x, const doubles& thresholds);
+extern "C" SEXP _cpp11armadillotest_openmp_thresholds_(SEXP x, SEXP thresholds) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(openmp_thresholds_(cpp11::as_cpp<cpp11::decay_t<const doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const doubles&>>(thresholds)));
+  END_CPP11
+}
+// 11_simd_openmp.cpp
+list openmp_threads_(const doubles& x, const int& n);
+extern "C" SEXP _cpp11armadillotest_openmp_threads_(SEXP x, SEXP n) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(openmp_threads_(cpp11::as_cpp<cpp11::decay_t<const doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const int&>>(n)));
+  END_CPP11
+}
+// 11_simd_openmp.cpp
+doubles nested_tasks_(const doubles& x, const int& n, const bool& tasks);
+extern "C" SEXP _cpp11armadillotest_nested_tasks_(SEXP x, SEXP n, SEXP tasks) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(nested_tasks_(cpp11::as_cpp<cpp11::decay_t<const doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<const bool&>>(tasks)));
+  END_CPP11
+}
+// 11_simd_openmp.cpp
+list elementwise_integer_(const integers& x, const integers& y);
+extern "C" SEXP _cpp11armadillotest_elementwise_integer_(SEXP x, SEXP y) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(elementwise_integer_(cpp11::as_cpp<cpp11::decay_t<const integers&>>(x), cpp11::as_cpp<cpp11::decay_t<const integers&>>(y)));
+  END_CPP11
+}
+// 11_simd_openmp.cpp
+logicals gmm_parallel_(const int& n, const int& d, const int& n_models, const bool& interrupt);
+extern "C" SEXP _cpp11armadillotest_gmm_parallel_(SEXP n, SEXP d, SEXP n_models, SEXP interrupt) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(gmm_parallel_(cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<const int&>>(d), cpp11::as_cpp<cpp11::decay_t<const int&>>(n_models), cpp11::as_cpp<cpp11::decay_t<const bool&>>(interrupt)));
+  END_CPP11
+}
+// 11_simd_openmp.cpp
+bool kmeans_deadline_(const int& n, const int& d, const int& k, const double& seconds, const bool& cancel);
+extern "C" SEXP _cpp11armadillotest_kmeans_deadline_(SEXP n, SEXP d, SEXP k, SEXP seconds, SEXP cancel) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(kmeans_deadline_(cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<const int&>>(d), cpp11::as_cpp<cpp11::decay_t<const int&>>(k), cpp11::as_cpp<cpp11::decay_t<const double&>>(seconds), cpp11::as_cpp<cpp11::decay_t<const bool&>>(cancel)));
+  END_CPP11
+}
 
 extern "C" {
 static const R_CallMethodDef CallEntries[] = {
@@ -1804,6 +2056,7 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp11armadillotest_column1_",                          (DL_FUNC) &_cpp11armadillotest_column1_,                          2},
     {"_cpp11armadillotest_compatibility1_",                   (DL_FUNC) &_cpp11armadillotest_compatibility1_,                   1},
     {"_cpp11armadillotest_compatibility2_",                   (DL_FUNC) &_cpp11armadillotest_compatibility2_,                   1},
+    {"_cpp11armadillotest_complexes_matrix_conj",             (DL_FUNC) &_cpp11armadillotest_complexes_matrix_conj,             1},
     {"_cpp11armadillotest_cond1_",                            (DL_FUNC) &_cpp11armadillotest_cond1_,                            1},
     {"_cpp11armadillotest_conj1_",                            (DL_FUNC) &_cpp11armadillotest_conj1_,                            1},
     {"_cpp11armadillotest_conv1_",                            (DL_FUNC) &_cpp11armadillotest_conv1_,                            2},
@@ -1831,12 +2084,16 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp11armadillotest_eig_pair1_",                        (DL_FUNC) &_cpp11armadillotest_eig_pair1_,                        2},
     {"_cpp11armadillotest_eig_sym1_",                         (DL_FUNC) &_cpp11armadillotest_eig_sym1_,                         2},
     {"_cpp11armadillotest_eig_sym2_",                         (DL_FUNC) &_cpp11armadillotest_eig_sym2_,                         3},
+    {"_cpp11armadillotest_eigen_gen_complexes",               (DL_FUNC) &_cpp11armadillotest_eigen_gen_complexes,               1},
     {"_cpp11armadillotest_eigen_gen_dbl_complex_wrapper",     (DL_FUNC) &_cpp11armadillotest_eigen_gen_dbl_complex_wrapper,     1},
     {"_cpp11armadillotest_eigen_gen_mat",                     (DL_FUNC) &_cpp11armadillotest_eigen_gen_mat,                     1},
     {"_cpp11armadillotest_eigen_gen_mat_complex_wrapper",     (DL_FUNC) &_cpp11armadillotest_eigen_gen_mat_complex_wrapper,     1},
     {"_cpp11armadillotest_eigen_gen_no_wrapper",              (DL_FUNC) &_cpp11armadillotest_eigen_gen_no_wrapper,              1},
     {"_cpp11armadillotest_eigen_sym_dbl",                     (DL_FUNC) &_cpp11armadillotest_eigen_sym_dbl,                     1},
     {"_cpp11armadillotest_eigen_sym_mat",                     (DL_FUNC) &_cpp11armadillotest_eigen_sym_mat,                     1},
+    {"_cpp11armadillotest_elementwise_integer_",              (DL_FUNC) &_cpp11armadillotest_elementwise_integer_,              2},
+    {"_cpp11armadillotest_elementwise_math_",                 (DL_FUNC) &_cpp11armadillotest_elementwise_math_,                 3},
+    {"_cpp11armadillotest_elementwise_simd_",                 (DL_FUNC) &_cpp11armadillotest_elementwise_simd_,                 2},
     {"_cpp11armadillotest_eps1_",                             (DL_FUNC) &_cpp11armadillotest_eps1_,                             1},
     {"_cpp11armadillotest_expmat1_",                          (DL_FUNC) &_cpp11armadillotest_expmat1_,                          1},
     {"_cpp11armadillotest_expmat_sym1_",                      (DL_FUNC) &_cpp11armadillotest_expmat_sym1_,                      1},
@@ -1854,6 +2111,7 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp11armadillotest_flip1_",                            (DL_FUNC) &_cpp11armadillotest_flip1_,                            1},
     {"_cpp11armadillotest_for_each1_",                        (DL_FUNC) &_cpp11armadillotest_for_each1_,                        1},
     {"_cpp11armadillotest_gmm1_",                             (DL_FUNC) &_cpp11armadillotest_gmm1_,                             2},
+    {"_cpp11armadillotest_gmm_parallel_",                     (DL_FUNC) &_cpp11armadillotest_gmm_parallel_,                     4},
     {"_cpp11armadillotest_has_inf1_",                         (DL_FUNC) &_cpp11armadillotest_has_inf1_,                         1},
     {"_cpp11armadillotest_has_nan1_",                         (DL_FUNC) &_cpp11armadillotest_has_nan1_,                         1},
     {"_cpp11armadillotest_hess1_",                            (DL_FUNC) &_cpp11armadillotest_hess1_,                            1},
@@ -1897,6 +2155,8 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp11armadillotest_join_cubes1_",                      (DL_FUNC) &_cpp11armadillotest_join_cubes1_,                      1},
     {"_cpp11armadillotest_join_rows1_",                       (DL_FUNC) &_cpp11armadillotest_join_rows1_,                       1},
     {"_cpp11armadillotest_kmeans1_",                          (DL_FUNC) &_cpp11armadillotest_kmeans1_,                          2},
+    {"_cpp11armadillotest_kmeans_deadline_",                  (DL_FUNC) &_cpp11armadillotest_kmeans_deadline_,                  5},
+    {"_cpp11armadillotest_kmeans_interrupt_",                 (DL_FUNC) &_cpp11armadillotest_kmeans_interrupt_,                 2},
     {"_cpp11armadillotest_kron1_",                            (DL_FUNC) &_cpp11armadillotest_kron1_,                            1},
     {"_cpp11armadillotest_linspace1_",                        (DL_FUNC) &_cpp11armadillotest_linspace1_,                        1},
     {"_cpp11armadillotest_log_det1_",                         (DL_FUNC) &_cpp11armadillotest_log_det1_,                         1},
@@ -1915,6 +2175,7 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp11armadillotest_memptr1_",                          (DL_FUNC) &_cpp11armadillotest_memptr1_,                          1},
     {"_cpp11armadillotest_misc1_",                            (DL_FUNC) &_cpp11armadillotest_misc1_,                            1},
     {"_cpp11armadillotest_mvnrnd1_",                          (DL_FUNC) &_cpp11armadillotest_mvnrnd1_,                          2},
+    {"_cpp11armadillotest_nested_tasks_",                     (DL_FUNC) &_cpp11armadillotest_nested_tasks_,                     3},
     {"_cpp11armadillotest_nonzeros1_",                        (DL_FUNC) &_cpp11armadillotest_nonzeros1_,                        1},
     {"_cpp11armadillotest_norm1_",                            (DL_FUNC) &_cpp11armadillotest_norm1_,                            1},
     {"_cpp11armadillotest_norm2est1_",                        (DL_FUNC) &_cpp11armadillotest_norm2est1_,                        1},
@@ -1929,6 +2190,8 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp11armadillotest_ols_qr_mat",                        (DL_FUNC) &_cpp11armadillotest_ols_qr_mat,                        3},
     {"_cpp11armadillotest_ones1_",                            (DL_FUNC) &_cpp11armadillotest_ones1_,                            1},
     {"_cpp11armadillotest_ones2_",                            (DL_FUNC) &_cpp11armadillotest_ones2_,                            1},
+    {"_cpp11armadillotest_openmp_threads_",                   (DL_FUNC) &_cpp11armadillotest_openmp_threads_,                   2},
+    {"_cpp11armadillotest_openmp_thresholds_",                (DL_FUNC) &_cpp11armadillotest_openmp_thresholds_,                2},
     {"_cpp11armadillotest_orth1_",                            (DL_FUNC) &_cpp11armadillotest_orth1_,                            1},
     {"_cpp11armadillotest_pinv1_",                            (DL_FUNC) &_cpp11armadillotest_pinv1_,                            1},
     {"_cpp11armadillotest_poisson_",                          (DL_FUNC) &_cpp11armadillotest_poisson_,                          2},
@@ -1945,7 +2208,14 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp11armadillotest_randn1_",                           (DL_FUNC) &_cpp11armadillotest_randn1_,                           1},
     {"_cpp11armadillotest_randn2_",                           (DL_FUNC) &_cpp11armadillotest_randn2_,                           1},
     {"_cpp11armadillotest_randn3_",                           (DL_FUNC) &_cpp11armadillotest_randn3_,                           1},
+    {"_cpp11armadillotest_random_gamma_n",                    (DL_FUNC) &_cpp11armadillotest_random_gamma_n,                    3},
+    {"_cpp11armadillotest_random_integers_n",                 (DL_FUNC) &_cpp11armadillotest_random_integers_n,                 3},
     {"_cpp11armadillotest_random_matrix_nxn",                 (DL_FUNC) &_cpp11armadillotest_random_matrix_nxn,                 1},
+    {"_cpp11armadillotest_random_mvn",                        (DL_FUNC) &_cpp11armadillotest_random_mvn,                        3},
+    {"_cpp11armadillotest_random_normal_nxm",                 (DL_FUNC) &_cpp11armadillotest_random_normal_nxm,                 2},
+    {"_cpp11armadillotest_random_permutation_n",              (DL_FUNC) &_cpp11armadillotest_random_permutation_n,              1},
+    {"_cpp11armadillotest_random_uniform_n",                  (DL_FUNC) &_cpp11armadillotest_random_uniform_n,                  3},
+    {"_cpp11armadillotest_random_wishart_mean",               (DL_FUNC) &_cpp11armadillotest_random_wishart_mean,               3},
     {"_cpp11armadillotest_randperm1_",                        (DL_FUNC) &_cpp11armadillotest_randperm1_,                        2},
     {"_cpp11armadillotest_randu1_",                           (DL_FUNC) &_cpp11armadillotest_randu1_,                           1},
     {"_cpp11armadillotest_randu2_",                           (DL_FUNC) &_cpp11armadillotest_randu2_,                           1},
@@ -2004,7 +2274,13 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp11armadillotest_swap_rows1_",                       (DL_FUNC) &_cpp11armadillotest_swap_rows1_,                       1},
     {"_cpp11armadillotest_syl1_",                             (DL_FUNC) &_cpp11armadillotest_syl1_,                             3},
     {"_cpp11armadillotest_symmatu1_",                         (DL_FUNC) &_cpp11armadillotest_symmatu1_,                         1},
+    {"_cpp11armadillotest_test_SpMat_to_sparse_Matrix",       (DL_FUNC) &_cpp11armadillotest_test_SpMat_to_sparse_Matrix,       2},
+    {"_cpp11armadillotest_test_dense_to_SpMat_tol",           (DL_FUNC) &_cpp11armadillotest_test_dense_to_SpMat_tol,           2},
+    {"_cpp11armadillotest_test_dense_to_sp_fmat",             (DL_FUNC) &_cpp11armadillotest_test_dense_to_sp_fmat,             1},
     {"_cpp11armadillotest_test_dgCMatrix_to_SpMat",           (DL_FUNC) &_cpp11armadillotest_test_dgCMatrix_to_SpMat,           1},
+    {"_cpp11armadillotest_test_dgCMatrix_to_SpMat_trusted",   (DL_FUNC) &_cpp11armadillotest_test_dgCMatrix_to_SpMat_trusted,   1},
+    {"_cpp11armadillotest_test_dgCMatrix_to_sp_fmat",         (DL_FUNC) &_cpp11armadillotest_test_dgCMatrix_to_sp_fmat,         1},
+    {"_cpp11armadillotest_test_sparse_Matrix_to_SpMat",       (DL_FUNC) &_cpp11armadillotest_test_sparse_Matrix_to_SpMat,       2},
     {"_cpp11armadillotest_toeplitz1_",                        (DL_FUNC) &_cpp11armadillotest_toeplitz1_,                        1},
     {"_cpp11armadillotest_trace1_",                           (DL_FUNC) &_cpp11armadillotest_trace1_,                           1},
     {"_cpp11armadillotest_trans1_",                           (DL_FUNC) &_cpp11armadillotest_trans1_,                           1},
@@ -2015,16 +2291,28 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp11armadillotest_trig1_",                            (DL_FUNC) &_cpp11armadillotest_trig1_,                            1},
     {"_cpp11armadillotest_trimatu1_",                         (DL_FUNC) &_cpp11armadillotest_trimatu1_,                         1},
     {"_cpp11armadillotest_trimatu_ind1_",                     (DL_FUNC) &_cpp11armadillotest_trimatu_ind1_,                     1},
+    {"_cpp11armadillotest_typedef_Col_altrep",                (DL_FUNC) &_cpp11armadillotest_typedef_Col_altrep,                1},
     {"_cpp11armadillotest_typedef_Col_double",                (DL_FUNC) &_cpp11armadillotest_typedef_Col_double,                1},
     {"_cpp11armadillotest_typedef_Col_int",                   (DL_FUNC) &_cpp11armadillotest_typedef_Col_int,                   1},
+    {"_cpp11armadillotest_typedef_Cube_double",               (DL_FUNC) &_cpp11armadillotest_typedef_Cube_double,               1},
+    {"_cpp11armadillotest_typedef_Cube_int",                  (DL_FUNC) &_cpp11armadillotest_typedef_Cube_int,                  1},
+    {"_cpp11armadillotest_typedef_Mat_altrep",                (DL_FUNC) &_cpp11armadillotest_typedef_Mat_altrep,                1},
     {"_cpp11armadillotest_typedef_Mat_double",                (DL_FUNC) &_cpp11armadillotest_typedef_Mat_double,                1},
     {"_cpp11armadillotest_typedef_Mat_int",                   (DL_FUNC) &_cpp11armadillotest_typedef_Mat_int,                   1},
     {"_cpp11armadillotest_typedef_SpMat_double",              (DL_FUNC) &_cpp11armadillotest_typedef_SpMat_double,              1},
     {"_cpp11armadillotest_typedef_SpMat_int",                 (DL_FUNC) &_cpp11armadillotest_typedef_SpMat_int,                 1},
+    {"_cpp11armadillotest_typedef_data_frame",                (DL_FUNC) &_cpp11armadillotest_typedef_data_frame,                1},
+    {"_cpp11armadillotest_typedef_data_frame_cols",           (DL_FUNC) &_cpp11armadillotest_typedef_data_frame_cols,           2},
     {"_cpp11armadillotest_typedef_dblmat_exchangeability",    (DL_FUNC) &_cpp11armadillotest_typedef_dblmat_exchangeability,    1},
+    {"_cpp11armadillotest_typedef_long_long_to_integers",     (DL_FUNC) &_cpp11armadillotest_typedef_long_long_to_integers,     1},
+    {"_cpp11armadillotest_typedef_memory_alignment",          (DL_FUNC) &_cpp11armadillotest_typedef_memory_alignment,          1},
+    {"_cpp11armadillotest_typedef_sort_index",                (DL_FUNC) &_cpp11armadillotest_typedef_sort_index,                1},
     {"_cpp11armadillotest_typedef_spmat_exchangeability",     (DL_FUNC) &_cpp11armadillotest_typedef_spmat_exchangeability,     1},
     {"_cpp11armadillotest_typedef_spmat_int_exchangeability", (DL_FUNC) &_cpp11armadillotest_typedef_spmat_int_exchangeability, 1},
+    {"_cpp11armadillotest_typedef_umat_to_integers",          (DL_FUNC) &_cpp11armadillotest_typedef_umat_to_integers,          1},
     {"_cpp11armadillotest_typedef_uvec",                      (DL_FUNC) &_cpp11armadillotest_typedef_uvec,                      1},
+    {"_cpp11armadillotest_typedef_uvec_index",                (DL_FUNC) &_cpp11armadillotest_typedef_uvec_index,                2},
+    {"_cpp11armadillotest_typedef_uword_size",                (DL_FUNC) &_cpp11armadillotest_typedef_uword_size,                0},
     {"_cpp11armadillotest_unique1_",                          (DL_FUNC) &_cpp11armadillotest_unique1_,                          1},
     {"_cpp11armadillotest_var1_",                             (DL_FUNC) &_cpp11armadillotest_var1_,                             2},
     {"_cpp11armadillotest_vecnorm1_",                         (DL_FUNC) &_cpp11armadillotest_vecnorm1_,                         1},
@@ -2036,8 +2324,11 @@ static const R_CallMethodDef CallEntries[] = {
 };
 }
 
+void init_altrep_classes(DllInfo* dll);
+
 extern "C" attribute_visible void R_init_cpp11armadillotest(DllInfo* dll){
   R_registerRoutines(dll, NULL, CallEntries, NULL, NULL);
   R_useDynamicSymbols(dll, FALSE);
+  init_altrep_classes(dll);
   R_forceSymbols(dll, TRUE);
 }
@@ -27,6 +27,24 @@
 // workaround to avoid R check() notes about std::cerr
 #include "r_messages.hpp"
 
+// opt-in R-backed memory for results returned to R (CPP11ARMADILLO_USE_R_ALLOC)
+#include "r_alloc.hpp"
+
+// opt-in pooled allocator for temporaries (CPP11ARMADILLO_USE_POOL)
+#include "r_pool.hpp"
+
+// cooperative cancellation of long-running kernels (CPP11ARMADILLO_NO_INTERRUPT)
+#include "r_interrupt.hpp"
+
+// opt-in allocation and timing counters (CPP11ARMADILLO_USE_TELEMETRY)
+#include "r_telemetry.hpp"
+
+// element-wise SIMD kernels with run time dispatch (CPP11ARMADILLO_NO_SIMD)
+#include "r_simd.hpp"
+
+// OpenMP thresholds per cost class, calibrated on the host (Parallel::calibrate())
+#include "r_parallel.hpp"
+
 #include "armadillo/config.hpp"
 #include "armadillo/compiler_check.hpp"
 
@@ -57,6 +75,11 @@
 #include <chrono>
 #include <atomic>
 
+// huge pages for large blocks (CPP11ARMADILLO_USE_HUGEPAGES)
+#if defined(CPP11ARMADILLO_USE_HUGEPAGES) && defined(__linux__)
+  #include <sys/mman.h>
+#endif
+
 #if defined(ARMA_USE_STD_MUTEX)
   #include <mutex>
 #endif
@@ -4453,6 +4453,7 @@ inline bool auxlib::solve_square_fast(Mat<typename T1::elem_type>& out,
                                       Mat<typename T1::elem_type>& A,
                                       const Base<typename T1::elem_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_square_fast");
 
   out = B_expr.get_ref();
 
@@ -4505,6 +4506,7 @@ inline bool auxlib::solve_square_rcond(Mat<typename T1::elem_type>& out,
                                        Mat<typename T1::elem_type>& A,
                                        const Base<typename T1::elem_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_square_rcond");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -4586,6 +4588,7 @@ inline bool auxlib::solve_square_refine(Mat<typename T1::pod_type>& out,
                                         const Base<typename T1::pod_type, T1>& B_expr,
                                         const bool equilibrate) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_square_refine");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -4676,6 +4679,7 @@ inline bool auxlib::solve_square_refine(
     Mat<std::complex<typename T1::pod_type> >& A,
     const Base<std::complex<typename T1::pod_type>, T1>& B_expr, const bool equilibrate) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_square_refine");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -4764,6 +4768,7 @@ inline bool auxlib::solve_sym_fast(Mat<typename T1::pod_type>& out,
                                    Mat<typename T1::pod_type>& A,
                                    const Base<typename T1::pod_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_sym_fast");
 
   out = B_expr.get_ref();
 
@@ -4842,6 +4847,7 @@ inline bool auxlib::solve_sym_fast(
     Mat<std::complex<typename T1::pod_type> >& A,
     const Base<std::complex<typename T1::pod_type>, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_sym_fast");
 
   out = B_expr.get_ref();
 
@@ -4929,6 +4935,7 @@ inline bool auxlib::solve_sym_rcond(Mat<typename T1::pod_type>& out,
                                     Mat<typename T1::pod_type>& A,
                                     const Base<typename T1::pod_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_sym_rcond");
 
   out = B_expr.get_ref();
 
@@ -5037,6 +5044,7 @@ inline bool auxlib::solve_sym_rcond(
     Mat<std::complex<typename T1::pod_type> >& A,
     const Base<std::complex<typename T1::pod_type>, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_sym_rcond");
 
   out = B_expr.get_ref();
 
@@ -5138,6 +5146,7 @@ inline bool auxlib::solve_sympd_fast(Mat<typename T1::elem_type>& out,
                                      Mat<typename T1::elem_type>& A,
                                      const Base<typename T1::elem_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_sympd_fast");
 
 #if defined(ARMA_CRIPPLED_LAPACK)
   {
@@ -5212,6 +5221,7 @@ inline bool auxlib::solve_sympd_rcond(Mat<typename T1::pod_type>& out,
                                       Mat<typename T1::pod_type>& A,
                                       const Base<typename T1::pod_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_sympd_rcond");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -5292,6 +5302,7 @@ inline bool auxlib::solve_sympd_rcond(
     typename T1::pod_type& out_rcond, Mat<std::complex<typename T1::pod_type> >& A,
     const Base<std::complex<typename T1::pod_type>, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_sympd_rcond");
 
 #if defined(ARMA_CRIPPLED_LAPACK)
   {
@@ -5383,6 +5394,7 @@ inline bool auxlib::solve_sympd_refine(Mat<typename T1::pod_type>& out,
                                        const Base<typename T1::pod_type, T1>& B_expr,
                                        const bool equilibrate) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_sympd_refine");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -5472,6 +5484,7 @@ inline bool auxlib::solve_sympd_refine(
     Mat<std::complex<typename T1::pod_type> >& A,
     const Base<std::complex<typename T1::pod_type>, T1>& B_expr, const bool equilibrate) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_sympd_refine");
 
 #if defined(ARMA_CRIPPLED_LAPACK)
   {
@@ -5568,6 +5581,7 @@ inline bool auxlib::solve_rect_fast(Mat<typename T1::elem_type>& out,
                                     Mat<typename T1::elem_type>& A,
                                     const Base<typename T1::elem_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_rect_fast");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -5661,6 +5675,7 @@ inline bool auxlib::solve_rect_rcond(Mat<typename T1::elem_type>& out,
                                      Mat<typename T1::elem_type>& A,
                                      const Base<typename T1::elem_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_rect_rcond");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -5791,6 +5806,7 @@ inline bool auxlib::solve_approx_svd(Mat<typename T1::pod_type>& out,
                                      Mat<typename T1::pod_type>& A,
                                      const Base<typename T1::pod_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_approx_svd");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -5927,6 +5943,7 @@ inline bool auxlib::solve_approx_svd(
     Mat<std::complex<typename T1::pod_type> >& A,
     const Base<std::complex<typename T1::pod_type>, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_approx_svd");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -6079,6 +6096,7 @@ inline bool auxlib::solve_trimat_fast(Mat<typename T1::elem_type>& out,
                                       const Base<typename T1::elem_type, T1>& B_expr,
                                       const uword layout) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_trimat_fast");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -6130,6 +6148,7 @@ inline bool auxlib::solve_trimat_rcond(Mat<typename T1::elem_type>& out,
                                        const Base<typename T1::elem_type, T1>& B_expr,
                                        const uword layout) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_trimat_rcond");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -6193,6 +6212,7 @@ inline bool auxlib::solve_band_fast(Mat<typename T1::pod_type>& out,
                                     const uword KU,
                                     const Base<typename T1::pod_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_band_fast");
 
   return auxlib::solve_band_fast_common(out, A, KL, KU, B_expr);
 }
@@ -6204,6 +6224,7 @@ inline bool auxlib::solve_band_fast(
     Mat<std::complex<typename T1::pod_type> >& A, const uword KL, const uword KU,
     const Base<std::complex<typename T1::pod_type>, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_band_fast");
 
 #if defined(ARMA_CRIPPLED_LAPACK)
   {
@@ -6297,6 +6318,7 @@ inline bool auxlib::solve_band_rcond(Mat<typename T1::pod_type>& out,
                                      const uword KU,
                                      const Base<typename T1::pod_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_band_rcond");
 
   return auxlib::solve_band_rcond_common(out, out_rcond, A, KL, KU, B_expr);
 }
@@ -6308,6 +6330,7 @@ inline bool auxlib::solve_band_rcond(
     Mat<std::complex<typename T1::pod_type> >& A, const uword KL, const uword KU,
     const Base<std::complex<typename T1::pod_type>, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_band_rcond");
 
 #if defined(ARMA_CRIPPLED_LAPACK)
   {
@@ -6429,6 +6452,7 @@ inline bool auxlib::solve_band_refine(Mat<typename T1::pod_type>& out,
                                       const Base<typename T1::pod_type, T1>& B_expr,
                                       const bool equilibrate) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_band_refine");
 
 #if defined(ARMA_USE_LAPACK)
   {
@@ -6513,6 +6537,7 @@ inline bool auxlib::solve_band_refine(
     Mat<std::complex<typename T1::pod_type> >& A, const uword KL, const uword KU,
     const Base<std::complex<typename T1::pod_type>, T1>& B_expr, const bool equilibrate) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_band_refine");
 
 #if defined(ARMA_CRIPPLED_LAPACK)
   {
@@ -6609,6 +6634,7 @@ inline bool auxlib::solve_tridiag_fast(Mat<typename T1::pod_type>& out,
                                        Mat<typename T1::pod_type>& A,
                                        const Base<typename T1::pod_type, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_tridiag_fast");
 
   return auxlib::solve_tridiag_fast_common(out, A, B_expr);
 }
@@ -6621,6 +6647,7 @@ inline bool auxlib::solve_tridiag_fast(
     Mat<std::complex<typename T1::pod_type> >& A,
     const Base<std::complex<typename T1::pod_type>, T1>& B_expr) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("auxlib::solve_tridiag_fast");
 
 #if defined(ARMA_CRIPPLED_LAPACK)
   {
@@ -226,6 +226,37 @@
 #pragma message("WARNING: use ARMA_COUT_STREAM and ARMA_CERR_STREAM instead")
 #endif
 
+// Pacha: polling points for the cancellation token in r_interrupt.hpp, no-ops when
+// the token is disabled. ARMA_CHECK_INTERRUPT() is true when the kernel has to stop.
+
+#if !defined(ARMA_CHECK_INTERRUPT)
+#define ARMA_CHECK_INTERRUPT() false
+#define ARMA_INTERRUPT_REQUESTED() false
+#endif
+
+// Pacha: allocation modes of memory::acquire(), used when posix_memalign() is
+// available. CPP11ARMADILLO_USE_ALIGN64 aligns blocks of at least
+// CPP11ARMADILLO_ALIGN64_THRESHOLD bytes to 64 bytes, CPP11ARMADILLO_USE_HUGEPAGES
+// aligns blocks of at least CPP11ARMADILLO_HUGEPAGE_THRESHOLD bytes to 2 MB and
+// marks them with madvise(MADV_HUGEPAGE) on Linux
+
+#if !defined(CPP11ARMADILLO_ALIGN64_THRESHOLD)
+#define CPP11ARMADILLO_ALIGN64_THRESHOLD 1024
+#endif
+
+#if !defined(CPP11ARMADILLO_HUGEPAGE_THRESHOLD)
+#define CPP11ARMADILLO_HUGEPAGE_THRESHOLD 33554432
+#endif
+
+// Pacha: hooks of the opt-in telemetry in r_telemetry.hpp, no-ops unless
+// CPP11ARMADILLO_USE_TELEMETRY is defined
+
+#if !defined(ARMA_TELEMETRY_SCOPE)
+#define ARMA_TELEMETRY_ACQUIRE(mem, n_bytes)
+#define ARMA_TELEMETRY_RELEASE(mem)
+#define ARMA_TELEMETRY_SCOPE(name)
+#endif
+
 // Pacha: R check() does not like std::cerr
 // I use stopstream() instead of stopstream so that ARMA_CERR_STREAM is a
 // std::ostream& forward declaration of stopstream()
@@ -1431,6 +1431,7 @@ template <typename eT>
 inline bool diskio::load_raw_ascii(Mat<eT>& x, const std::string& name,
                                    std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_raw_ascii");
 
   std::ifstream f;
 
@@ -1542,6 +1543,7 @@ template <typename eT>
 inline bool diskio::load_raw_binary(Mat<eT>& x, const std::string& name,
                                     std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_raw_binary");
 
   std::ifstream f;
   f.open(name, std::fstream::binary);
@@ -1600,6 +1602,7 @@ template <typename eT>
 inline bool diskio::load_arma_ascii(Mat<eT>& x, const std::string& name,
                                     std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_arma_ascii");
 
   std::ifstream f;
 
@@ -1696,6 +1699,7 @@ inline bool diskio::load_csv_ascii(Mat<eT>& x, const std::string& name,
                                    const bool with_header, const char separator,
                                    const bool strict) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_csv_ascii");
 
   std::ifstream f;
 
@@ -2175,6 +2179,7 @@ template <typename eT>
 inline bool diskio::load_coord_ascii(Mat<eT>& x, const std::string& name,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_coord_ascii");
 
   std::ifstream f;
 
@@ -2431,6 +2436,7 @@ template <typename eT>
 inline bool diskio::load_arma_binary(Mat<eT>& x, const std::string& name,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_arma_binary");
 
   std::ifstream f;
   f.open(name, std::fstream::binary);
@@ -2533,6 +2539,7 @@ template <typename eT>
 inline bool diskio::load_pgm_binary(Mat<eT>& x, const std::string& name,
                                     std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_pgm_binary");
 
   std::fstream f;
   f.open(name, std::fstream::in | std::fstream::binary);
@@ -2631,6 +2638,7 @@ template <typename T>
 inline bool diskio::load_pgm_binary(Mat<std::complex<T> >& x, const std::string& name,
                                     std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_pgm_binary");
 
   uchar_mat tmp;
   const bool load_okay = diskio::load_pgm_binary(tmp, name, err_msg);
@@ -2659,6 +2667,7 @@ template <typename eT>
 inline bool diskio::load_hdf5_binary(Mat<eT>& x, const hdf5_name& spec,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_hdf5_binary");
 
 #if defined(ARMA_USE_HDF5)
   {
@@ -2783,6 +2792,7 @@ template <typename eT>
 inline bool diskio::load_auto_detect(Mat<eT>& x, const std::string& name,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_auto_detect");
 
   if (diskio::is_readable(name) == false) {
     return false;
@@ -3178,6 +3188,7 @@ inline bool diskio::load_csv_ascii(SpMat<eT>& x, const std::string& name,
                                    std::string& err_msg, field<std::string>& header,
                                    const bool with_header, const char separator) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_csv_ascii");
 
   std::ifstream f;
 
@@ -3358,6 +3369,7 @@ template <typename eT>
 inline bool diskio::load_coord_ascii(SpMat<eT>& x, const std::string& name,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_coord_ascii");
 
   std::ifstream f;
 
@@ -3609,6 +3621,7 @@ template <typename eT>
 inline bool diskio::load_arma_binary(SpMat<eT>& x, const std::string& name,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_arma_binary");
 
   std::ifstream f;
   f.open(name, std::fstream::binary);
@@ -4073,6 +4086,7 @@ template <typename eT>
 inline bool diskio::load_raw_ascii(Cube<eT>& x, const std::string& name,
                                    std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_raw_ascii");
 
   Mat<eT> tmp;
   const bool load_okay = diskio::load_raw_ascii(tmp, name, err_msg);
@@ -4128,6 +4142,7 @@ template <typename eT>
 inline bool diskio::load_raw_binary(Cube<eT>& x, const std::string& name,
                                     std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_raw_binary");
 
   std::ifstream f;
   f.open(name, std::fstream::binary);
@@ -4181,6 +4196,7 @@ template <typename eT>
 inline bool diskio::load_arma_ascii(Cube<eT>& x, const std::string& name,
                                     std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_arma_ascii");
 
   std::ifstream f;
 
@@ -4275,6 +4291,7 @@ template <typename eT>
 inline bool diskio::load_arma_binary(Cube<eT>& x, const std::string& name,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_arma_binary");
 
   std::ifstream f;
   f.open(name, std::fstream::binary);
@@ -4365,6 +4382,7 @@ template <typename eT>
 inline bool diskio::load_hdf5_binary(Cube<eT>& x, const hdf5_name& spec,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_hdf5_binary");
 
 #if defined(ARMA_USE_HDF5)
   {
@@ -4493,6 +4511,7 @@ template <typename eT>
 inline bool diskio::load_auto_detect(Cube<eT>& x, const std::string& name,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_auto_detect");
 
   if (diskio::is_readable(name) == false) {
     return false;
@@ -4635,6 +4654,7 @@ template <typename T1>
 inline bool diskio::load_arma_binary(field<T1>& x, const std::string& name,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_arma_binary");
 
   std::ifstream f(name, std::fstream::binary);
 
@@ -4760,6 +4780,7 @@ inline bool diskio::save_std_string(const field<std::string>& x, std::ostream& f
 inline bool diskio::load_std_string(field<std::string>& x, const std::string& name,
                                     std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_std_string");
 
   std::ifstream f(name);
 
@@ -4848,6 +4869,7 @@ template <typename T1>
 inline bool diskio::load_auto_detect(field<T1>& x, const std::string& name,
                                      std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_auto_detect");
 
   std::fstream f;
   f.open(name, std::fstream::in | std::fstream::binary);
@@ -4906,6 +4928,7 @@ template <typename eT>
 inline bool diskio::load_ppm_binary(Cube<eT>& x, const std::string& name,
                                     std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_ppm_binary");
 
   std::fstream f;
   f.open(name, std::fstream::in | std::fstream::binary);
@@ -5066,6 +5089,7 @@ template <typename T1>
 inline bool diskio::load_ppm_binary(field<T1>& x, const std::string& name,
                                     std::string& err_msg) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("diskio::load_ppm_binary");
 
   std::fstream f;
   f.open(name, std::fstream::in | std::fstream::binary);
@@ -159,15 +159,15 @@
 
 #if defined(ARMA_USE_OPENMP)
 
-#define arma_applier_1_mp(operatorA, operatorB)                                          \
-  {                                                                                      \
-    const int n_threads = mp_thread_limit::get();                                        \
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)") for (uword i =   \
-                                                                                 0;      \
-                                                                             i < n_elem; \
-                                                                             ++i) {      \
-      out_mem[i] operatorA P1[i] operatorB P2[i];                                        \
-    }                                                                                    \
+// Pacha: split with mp_ranges() (mp_misc.hpp), so that it also runs as OpenMP tasks
+// inside a parallel region
+#define arma_applier_1_mp(operatorA, operatorB)                 \
+  {                                                             \
+    mp_ranges(n_elem, [&](const uword start, const uword end) { \
+      for (uword i = start; i < end; ++i) {                     \
+        out_mem[i] operatorA P1[i] operatorB P2[i];             \
+      }                                                         \
+    });                                                         \
   }
 
 #define arma_applier_2_mp(operatorA, operatorB)                                          \
@@ -229,6 +229,140 @@
 
 #endif
 
+// Pacha: explicit SIMD kernels (r_simd.hpp), see eop_core_meat.hpp. Besides a op b,
+// a % b + c and a * k + b are evaluated in a single pass.
+
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+
+template <typename eglue_type>
+struct eglue_simd {
+  static constexpr int op = -1;
+};
+
+// clang-format off
+template <> struct eglue_simd<eglue_plus> { static constexpr int op = SimdKernels::binary_plus; };
+template <> struct eglue_simd<eglue_minus> { static constexpr int op = SimdKernels::binary_minus; };
+template <> struct eglue_simd<eglue_schur> { static constexpr int op = SimdKernels::binary_schur; };
+template <> struct eglue_simd<eglue_div> { static constexpr int op = SimdKernels::binary_div; };
+// clang-format on
+
+// a % b + c
+
+template <typename T1, typename T2, typename T3>
+inline bool eglue_simd_apply(double* out,
+                             const eGlue<eGlue<T1, T2, eglue_schur>, T3, eglue_plus>& x,
+                             const bool use_mp, const simd_rank<2>&) {
+  const double* a = simd_mem(x.P1.Q.P1.get_ea());
+  const double* b = simd_mem(x.P1.Q.P2.get_ea());
+  const double* c = simd_mem(x.P2.get_ea());
+
+  if (a == nullptr || b == nullptr || c == nullptr) {
+    return false;
+  }
+
+  const SimdKernels::schur_plus_fn f = Simd::kernels().schur_plus;
+
+  simd_run(x.get_n_elem(), use_mp,
+           [&](const uword i, const uword n) { f(out + i, a + i, b + i, c + i, n); });
+
+  return true;
+}
+
+// c + a % b
+
+template <typename T1, typename T2, typename T3>
+inline bool eglue_simd_apply(double* out,
+                             const eGlue<T3, eGlue<T1, T2, eglue_schur>, eglue_plus>& x,
+                             const bool use_mp, const simd_rank<1>&) {
+  const double* a = simd_mem(x.P2.Q.P1.get_ea());
+  const double* b = simd_mem(x.P2.Q.P2.get_ea());
+  const double* c = simd_mem(x.P1.get_ea());
+
+  if (a == nullptr || b == nullptr || c == nullptr) {
+    return false;
+  }
+
+  const SimdKernels::schur_plus_fn f = Simd::kernels().schur_plus;
+
+  simd_run(x.get_n_elem(), use_mp,
+           [&](const uword i, const uword n) { f(out + i, a + i, b + i, c + i, n); });
+
+  return true;
+}
+
+// a * k + b
+
+template <typename T1, typename T2>
+inline bool eglue_simd_apply(double* out,
+                             const eGlue<eOp<T1, eop_scalar_times>, T2, eglue_plus>& x,
+                             const bool use_mp, const simd_rank<2>&) {
+  const double* a = simd_mem(x.P1.Q.P.get_ea());
+  const double* b = simd_mem(x.P2.get_ea());
+
+  if (a == nullptr || b == nullptr) {
+    return false;
+  }
+
+  const SimdKernels::times_plus_fn f = Simd::kernels().times_plus;
+  const double k = simd_scalar(x.P1.Q.aux);
+
+  simd_run(x.get_n_elem(), use_mp,
+           [&](const uword i, const uword n) { f(out + i, a + i, k, b + i, n); });
+
+  return true;
+}
+
+// b + a * k
+
+template <typename T1, typename T2>
+inline bool eglue_simd_apply(double* out,
+                             const eGlue<T2, eOp<T1, eop_scalar_times>, eglue_plus>& x,
+                             const bool use_mp, const simd_rank<1>&) {
+  const double* a = simd_mem(x.P2.Q.P.get_ea());
+  const double* b = simd_mem(x.P1.get_ea());
+
+  if (a == nullptr || b == nullptr) {
+    return false;
+  }
+
+  const SimdKernels::times_plus_fn f = Simd::kernels().times_plus;
+  const double k = simd_scalar(x.P2.Q.aux);
+
+  simd_run(x.get_n_elem(), use_mp,
+           [&](const uword i, const uword n) { f(out + i, a + i, k, b + i, n); });
+
+  return true;
+}
+
+// a op b
+
+template <typename T1, typename T2, typename eglue_type>
+inline bool eglue_simd_apply(double* out, const eGlue<T1, T2, eglue_type>& x,
+                             const bool use_mp, const simd_rank<0>&) {
+  const double* a = simd_mem(x.P1.get_ea());
+  const double* b = simd_mem(x.P2.get_ea());
+
+  if (eglue_simd<eglue_type>::op < 0 || a == nullptr || b == nullptr) {
+    return false;
+  }
+
+  const SimdKernels::binary_fn f =
+      Simd::kernels().binary[(eglue_simd<eglue_type>::op < 0) ? 0 : eglue_simd<eglue_type>::op];
+
+  simd_run(x.get_n_elem(), use_mp,
+           [&](const uword i, const uword n) { f(out + i, a + i, b + i, n); });
+
+  return true;
+}
+
+template <typename T1, typename T2, typename eglue_type>
+inline bool eglue_simd_apply(std::nullptr_t, const eGlue<T1, T2, eglue_type>&, const bool,
+                             const simd_rank<2>&) {
+  return false;
+}
+
+#endif
+
 //
 // matrices
 
@@ -240,8 +374,8 @@ inline void eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_t
   typedef typename T1::elem_type eT;
 
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp =
-      (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   // NOTE: we're assuming that the matrix has already been set to the correct size and
   // there is no aliasing; size setting and alias checking is done by either the Mat
@@ -252,7 +386,19 @@ inline void eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_t
   if (use_at == false) {
     const uword n_elem = x.get_n_elem();
 
-    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem)) {
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+    // Pacha: SIMD kernels (r_simd.hpp)
+    if (eglue_simd_apply(
+            simd_out(out_mem), x,
+            use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_nested(
+                          n_elem, mp_cost_class),
+            simd_rank<2>())) {
+      return;
+    }
+#endif
+
+    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_nested(
+                      n_elem, mp_cost_class)) {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
 
@@ -318,8 +464,8 @@ inline void eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_t
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
 
-    if (use_mp &&
-        mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(
+                      x.get_n_elem(), mp_cost_class)) {
       if (is_same_type<eglue_type, eglue_plus>::yes) {
         arma_applier_2_mp(=, +);
       } else if (is_same_type<eglue_type, eglue_minus>::yes) {
@@ -359,13 +505,14 @@ inline void eglue_core<eglue_type>::apply_inplace_plus(
   eT* out_mem = out.memptr();
 
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp =
-      (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (use_at == false) {
     const uword n_elem = x.get_n_elem();
 
-    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_nested(
+                      n_elem, mp_cost_class)) {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
 
@@ -428,8 +575,8 @@ inline void eglue_core<eglue_type>::apply_inplace_plus(
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
 
-    if (use_mp &&
-        mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(
+                      x.get_n_elem(), mp_cost_class)) {
       if (is_same_type<eglue_type, eglue_plus>::yes) {
         arma_applier_2_mp(+=, +);
       } else if (is_same_type<eglue_type, eglue_minus>::yes) {
@@ -469,13 +616,14 @@ inline void eglue_core<eglue_type>::apply_inplace_minus(
   eT* out_mem = out.memptr();
 
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp =
-      (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (use_at == false) {
     const uword n_elem = x.get_n_elem();
 
-    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_nested(
+                      n_elem, mp_cost_class)) {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
 
@@ -538,8 +686,8 @@ inline void eglue_core<eglue_type>::apply_inplace_minus(
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
 
-    if (use_mp &&
-        mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(
+                      x.get_n_elem(), mp_cost_class)) {
       if (is_same_type<eglue_type, eglue_plus>::yes) {
         arma_applier_2_mp(-=, +);
       } else if (is_same_type<eglue_type, eglue_minus>::yes) {
@@ -580,13 +728,14 @@ inline void eglue_core<eglue_type>::apply_inplace_schur(
   eT* out_mem = out.memptr();
 
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp =
-      (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (use_at == false) {
     const uword n_elem = x.get_n_elem();
 
-    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_nested(
+                      n_elem, mp_cost_class)) {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
 
@@ -649,8 +798,8 @@ inline void eglue_core<eglue_type>::apply_inplace_schur(
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
 
-    if (use_mp &&
-        mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(
+                      x.get_n_elem(), mp_cost_class)) {
       if (is_same_type<eglue_type, eglue_plus>::yes) {
         arma_applier_2_mp(*=, +);
       } else if (is_same_type<eglue_type, eglue_minus>::yes) {
@@ -691,13 +840,14 @@ inline void eglue_core<eglue_type>::apply_inplace_div(
   eT* out_mem = out.memptr();
 
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp =
-      (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (use_at == false) {
     const uword n_elem = x.get_n_elem();
 
-    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_nested(
+                      n_elem, mp_cost_class)) {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
 
@@ -760,8 +910,8 @@ inline void eglue_core<eglue_type>::apply_inplace_div(
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
 
-    if (use_mp &&
-        mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(
+                      x.get_n_elem(), mp_cost_class)) {
       if (is_same_type<eglue_type, eglue_plus>::yes) {
         arma_applier_2_mp(/=, +);
       } else if (is_same_type<eglue_type, eglue_minus>::yes) {
@@ -797,8 +947,8 @@ inline void eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out,
   typedef typename T1::elem_type eT;
 
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp =
-      (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   // NOTE: we're assuming that the cube has already been set to the correct size and there
   // is no aliasing; size setting and alias checking is done by either the Cube contructor
@@ -810,7 +960,8 @@ inline void eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out,
     const uword n_elem = out.n_elem;
 
     if (use_mp &&
-        mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem)) {
+        mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_nested(
+            n_elem, mp_cost_class)) {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
 
@@ -878,7 +1029,7 @@ inline void eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out,
     const ProxyCube<T2>& P2 = x.P2;
 
     if (use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(
-                      x.get_n_elem())) {
+                      x.get_n_elem(), mp_cost_class)) {
       if (is_same_type<eglue_type, eglue_plus>::yes) {
         arma_applier_3_mp(=, +);
       } else if (is_same_type<eglue_type, eglue_minus>::yes) {
@@ -920,14 +1071,15 @@ inline void eglue_core<eglue_type>::apply_inplace_plus(
   eT* out_mem = out.memptr();
 
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp =
-      (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (use_at == false) {
     const uword n_elem = out.n_elem;
 
     if (use_mp &&
-        mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem)) {
+        mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_nested(
+            n_elem, mp_cost_class)) {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
 
@@ -991,7 +1143,7 @@ inline void eglue_core<eglue_type>::apply_inplace_plus(
     const ProxyCube<T2>& P2 = x.P2;
 
     if (use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(
-                      x.get_n_elem())) {
+                      x.get_n_elem(), mp_cost_class)) {
       if (is_same_type<eglue_type, eglue_plus>::yes) {
         arma_applier_3_mp(+=, +);
       } else if (is_same_type<eglue_type, eglue_minus>::yes) {
@@ -1033,14 +1185,15 @@ inline void eglue_core<eglue_type>::apply_inplace_minus(
   eT* out_mem = out.memptr();
 
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp =
-      (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (use_at == false) {
     const uword n_elem = out.n_elem;
 
     if (use_mp &&
-        mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem)) {
+        mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_nested(
+            n_elem, mp_cost_class)) {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
 
@@ -1104,7 +1257,7 @@ inline void eglue_core<eglue_type>::apply_inplace_minus(
     const ProxyCube<T2>& P2 = x.P2;
 
     if (use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(
-                      x.get_n_elem())) {
+                      x.get_n_elem(), mp_cost_class)) {
       if (is_same_type<eglue_type, eglue_plus>::yes) {
         arma_applier_3_mp(-=, +);
       } else if (is_same_type<eglue_type, eglue_minus>::yes) {
@@ -1146,14 +1299,15 @@ inline void eglue_core<eglue_type>::apply_inplace_schur(
   eT* out_mem = out.memptr();
 
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp =
-      (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (use_at == false) {
     const uword n_elem = out.n_elem;
 
     if (use_mp &&
-        mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem)) {
+        mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_nested(
+            n_elem, mp_cost_class)) {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
 
@@ -1217,7 +1371,7 @@ inline void eglue_core<eglue_type>::apply_inplace_schur(
     const ProxyCube<T2>& P2 = x.P2;
 
     if (use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(
-                      x.get_n_elem())) {
+                      x.get_n_elem(), mp_cost_class)) {
       if (is_same_type<eglue_type, eglue_plus>::yes) {
         arma_applier_3_mp(*=, +);
       } else if (is_same_type<eglue_type, eglue_minus>::yes) {
@@ -1259,14 +1413,15 @@ inline void eglue_core<eglue_type>::apply_inplace_div(
   eT* out_mem = out.memptr();
 
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp =
-      (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (use_at == false) {
     const uword n_elem = out.n_elem;
 
     if (use_mp &&
-        mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem)) {
+        mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_nested(
+            n_elem, mp_cost_class)) {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
 
@@ -1330,7 +1485,7 @@ inline void eglue_core<eglue_type>::apply_inplace_div(
     const ProxyCube<T2>& P2 = x.P2;
 
     if (use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(
-                      x.get_n_elem())) {
+                      x.get_n_elem(), mp_cost_class)) {
       if (is_same_type<eglue_type, eglue_plus>::yes) {
         arma_applier_3_mp(/=, +);
       } else if (is_same_type<eglue_type, eglue_minus>::yes) {
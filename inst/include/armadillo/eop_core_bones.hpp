@@ -131,4 +131,128 @@ class eop_exp_approx {};
 class eop_approx_log {};
 class eop_approx_exp {};
 
+// Pacha: cost class of each operation for the OpenMP thresholds (see r_parallel.hpp).
+// Operations without openmp in Armadillo are cheap, the rest moderate unless listed
+// below. An expression takes the class of its most costly operation.
+
+template <typename eop_type>
+struct eop_mp_cost {
+  static constexpr int value =
+      eop_type::use_mp ? ::Parallel::moderate : ::Parallel::cheap;
+};
+
+template <>
+struct eop_mp_cost<eop_pow> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_tan> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_acos> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_asin> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_atan> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_cosh> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_sinh> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_acosh> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_asinh> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_atanh> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_lgamma> {
+  static constexpr int value = ::Parallel::expensive;
+};
+template <>
+struct eop_mp_cost<eop_tgamma> {
+  static constexpr int value = ::Parallel::expensive;
+};
+
+template <typename T1>
+struct mp_cost {
+  static constexpr int value = ::Parallel::cheap;
+};
+
+template <typename T1, typename eop_type>
+struct mp_cost<eOp<T1, eop_type> > {
+  static constexpr int value = (eop_mp_cost<eop_type>::value > mp_cost<T1>::value)
+                                   ? eop_mp_cost<eop_type>::value
+                                   : mp_cost<T1>::value;
+};
+
+template <typename T1, typename eop_type>
+struct mp_cost<eOpCube<T1, eop_type> > {
+  static constexpr int value = (eop_mp_cost<eop_type>::value > mp_cost<T1>::value)
+                                   ? eop_mp_cost<eop_type>::value
+                                   : mp_cost<T1>::value;
+};
+
+template <typename T1, typename T2, typename eglue_type>
+struct mp_cost<eGlue<T1, T2, eglue_type> > {
+  static constexpr int value = (mp_cost<T1>::value > mp_cost<T2>::value)
+                                   ? mp_cost<T1>::value
+                                   : mp_cost<T2>::value;
+};
+
+template <typename T1, typename T2, typename eglue_type>
+struct mp_cost<eGlueCube<T1, T2, eglue_type> > {
+  static constexpr int value = (mp_cost<T1>::value > mp_cost<T2>::value)
+                                   ? mp_cost<T1>::value
+                                   : mp_cost<T2>::value;
+};
+
+// Pacha: cost class used by eop_core and eglue_core to pick the threshold of an
+// expression. pow() with exponent 2 (real numbers) is a square, which costs no more
+// than its operand; it is the only case that depends on a value, not on the types.
+
+template <typename T1, typename eop_type>
+inline int eop_mp_class(const eOp<T1, eop_type>& x) {
+  typedef typename T1::elem_type eT;
+
+  return (is_same_type<eop_type, eop_pow>::value && is_cx<eT>::no && x.aux == eT(2))
+             ? mp_cost<T1>::value
+             : mp_cost<eOp<T1, eop_type> >::value;
+}
+
+template <typename T1, typename eop_type>
+inline int eop_mp_class(const eOpCube<T1, eop_type>& x) {
+  typedef typename T1::elem_type eT;
+
+  return (is_same_type<eop_type, eop_pow>::value && is_cx<eT>::no && x.aux == eT(2))
+             ? mp_cost<T1>::value
+             : mp_cost<eOpCube<T1, eop_type> >::value;
+}
+
+template <typename T1, typename T2, typename eglue_type>
+inline int eop_mp_class(const eGlue<T1, T2, eglue_type>&) {
+  return mp_cost<eGlue<T1, T2, eglue_type> >::value;
+}
+
+template <typename T1, typename T2, typename eglue_type>
+inline int eop_mp_class(const eGlueCube<T1, T2, eglue_type>&) {
+  return mp_cost<eGlueCube<T1, T2, eglue_type> >::value;
+}
+
 //! @}
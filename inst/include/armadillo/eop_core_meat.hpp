@@ -146,15 +146,15 @@
 
 #if defined(ARMA_USE_OPENMP)
 
-#define arma_applier_1_mp(operatorA)                                                     \
-  {                                                                                      \
-    const int n_threads = mp_thread_limit::get();                                        \
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)") for (uword i =   \
-                                                                                 0;      \
-                                                                             i < n_elem; \
-                                                                             ++i) {      \
-      out_mem[i] operatorA eop_core<eop_type>::process(P[i], k);                         \
-    }                                                                                    \
+// Pacha: split with mp_ranges() (mp_misc.hpp), so that it also runs as OpenMP tasks
+// inside a parallel region
+#define arma_applier_1_mp(operatorA)                               \
+  {                                                                \
+    mp_ranges(n_elem, [&](const uword start, const uword end) {    \
+      for (uword i = start; i < end; ++i) {                        \
+        out_mem[i] operatorA eop_core<eop_type>::process(P[i], k); \
+      }                                                            \
+    });                                                            \
   }
 
 #define arma_applier_2_mp(operatorA)                                                     \
@@ -216,6 +216,114 @@
 
 #endif
 
+// Pacha: explicit SIMD kernels for contiguous double precision memory (r_simd.hpp),
+// also used by eglue_core and the relational operators
+
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+
+// memory behind a proxy, or nullptr when it is not contiguous double precision memory
+
+inline const double* simd_mem(const double* mem) { return mem; }
+
+template <typename ea_type>
+inline const double* simd_mem(const ea_type&) {
+  return nullptr;
+}
+
+// output memory, or nullptr when it is not double precision (integer matrices keep the
+// scalar loops)
+
+inline double* simd_out(double* mem) { return mem; }
+
+template <typename eT>
+inline std::nullptr_t simd_out(eT*) {
+  return nullptr;
+}
+
+// output of the relational kernels, or nullptr when uword is not 64 bits
+
+inline unsigned long long* simd_mask_out(unsigned long long* mem) { return mem; }
+
+template <typename eT>
+inline std::nullptr_t simd_mask_out(eT*) {
+  return nullptr;
+}
+
+inline double simd_scalar(const double k) { return k; }
+
+template <typename eT>
+inline double simd_scalar(const eT&) {
+  return 0.0;
+}
+
+// overloads with a higher rank are preferred when several match
+template <int N>
+struct simd_rank : simd_rank<N - 1> {};
+
+template <>
+struct simd_rank<0> {};
+
+template <typename eop_type>
+struct eop_simd {
+  static constexpr int op = -1;
+};
+
+// clang-format off
+template <> struct eop_simd<eop_neg> { static constexpr int op = SimdKernels::neg; };
+template <> struct eop_simd<eop_scalar_plus> { static constexpr int op = SimdKernels::plus; };
+template <> struct eop_simd<eop_scalar_minus_pre> { static constexpr int op = SimdKernels::minus_pre; };
+template <> struct eop_simd<eop_scalar_minus_post> { static constexpr int op = SimdKernels::minus_post; };
+template <> struct eop_simd<eop_scalar_times> { static constexpr int op = SimdKernels::times; };
+template <> struct eop_simd<eop_scalar_div_pre> { static constexpr int op = SimdKernels::div_pre; };
+template <> struct eop_simd<eop_scalar_div_post> { static constexpr int op = SimdKernels::div_post; };
+template <> struct eop_simd<eop_square> { static constexpr int op = SimdKernels::square; };
+template <> struct eop_simd<eop_sqrt> { static constexpr int op = SimdKernels::sqrt; };
+template <> struct eop_simd<eop_abs> { static constexpr int op = SimdKernels::abs; };
+template <> struct eop_simd<eop_exp> { static constexpr int op = SimdKernels::exp; };
+template <> struct eop_simd<eop_log> { static constexpr int op = SimdKernels::log; };
+template <> struct eop_simd<eop_exp2> { static constexpr int op = SimdKernels::exp2; };
+template <> struct eop_simd<eop_exp10> { static constexpr int op = SimdKernels::exp10; };
+template <> struct eop_simd<eop_trunc_exp> { static constexpr int op = SimdKernels::trunc_exp; };
+template <> struct eop_simd<eop_log2> { static constexpr int op = SimdKernels::log2; };
+template <> struct eop_simd<eop_log10> { static constexpr int op = SimdKernels::log10; };
+template <> struct eop_simd<eop_trunc_log> { static constexpr int op = SimdKernels::trunc_log; };
+template <> struct eop_simd<eop_sin> { static constexpr int op = SimdKernels::sin; };
+template <> struct eop_simd<eop_cos> { static constexpr int op = SimdKernels::cos; };
+template <> struct eop_simd<eop_tanh> { static constexpr int op = SimdKernels::tanh; };
+template <> struct eop_simd<eop_erf> { static constexpr int op = SimdKernels::erf; };
+template <> struct eop_simd<eop_erfc> { static constexpr int op = SimdKernels::erfc; };
+// clang-format on
+
+template <typename eop_type, typename T1>
+inline bool eop_simd_apply(double* out, const eOp<T1, eop_type>& x, const bool use_mp) {
+  const double* a = simd_mem(x.P.get_ea());
+
+  if (eop_simd<eop_type>::op < 0 || a == nullptr) {
+    return false;
+  }
+
+  // the approximations are only used in the fast accuracy mode
+  if (eop_simd<eop_type>::op >= SimdKernels::exp && Simd::fast_math() == false) {
+    return false;
+  }
+
+  const SimdKernels::unary_fn f =
+      Simd::kernels().unary[(eop_simd<eop_type>::op < 0) ? 0 : eop_simd<eop_type>::op];
+  const double k = simd_scalar(x.aux);
+
+  simd_run(x.get_n_elem(), use_mp,
+           [&](const uword i, const uword n) { f(out + i, a + i, k, n); });
+
+  return true;
+}
+
+template <typename eop_type, typename T1>
+inline bool eop_simd_apply(std::nullptr_t, const eOp<T1, eop_type>&, const bool) {
+  return false;
+}
+
+#endif
+
 //
 // matrices
 
@@ -233,15 +341,21 @@ inline void eop_core<eop_type>::apply(outT& out, const eOp<T1, eop_type>& x) {
   const eT k = x.aux;
   eT* out_mem = out.memptr();
 
-  const bool use_mp =
-      (arma_config::openmp) &&
-      (eOp<T1, eop_type>::use_mp ||
-       (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (Proxy<T1>::use_at == false) {
     const uword n_elem = x.get_n_elem();
 
-    if (use_mp && mp_gate<eT>::eval(n_elem)) {
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+    // Pacha: SIMD kernels (r_simd.hpp)
+    if (eop_simd_apply(simd_out(out_mem), x,
+                       use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class))) {
+      return;
+    }
+#endif
+
+    if (use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class)) {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
 
       arma_applier_1_mp(=);
@@ -270,7 +384,7 @@ inline void eop_core<eop_type>::apply(outT& out, const eOp<T1, eop_type>& x) {
 
     const Proxy<T1>& P = x.P;
 
-    if (use_mp && mp_gate<eT>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost_class)) {
       arma_applier_2_mp(=);
     } else {
       arma_applier_2(=);
@@ -294,15 +408,13 @@ inline void eop_core<eop_type>::apply_inplace_plus(Mat<typename T1::elem_type>&
   const eT k = x.aux;
   eT* out_mem = out.memptr();
 
-  const bool use_mp =
-      (arma_config::openmp) &&
-      (eOp<T1, eop_type>::use_mp ||
-       (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (Proxy<T1>::use_at == false) {
     const uword n_elem = x.get_n_elem();
 
-    if (use_mp && mp_gate<eT>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class)) {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
 
       arma_applier_1_mp(+=);
@@ -328,7 +440,7 @@ inline void eop_core<eop_type>::apply_inplace_plus(Mat<typename T1::elem_type>&
   } else {
     const Proxy<T1>& P = x.P;
 
-    if (use_mp && mp_gate<eT>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost_class)) {
       arma_applier_2_mp(+=);
     } else {
       arma_applier_2(+=);
@@ -352,15 +464,13 @@ inline void eop_core<eop_type>::apply_inplace_minus(Mat<typename T1::elem_type>&
   const eT k = x.aux;
   eT* out_mem = out.memptr();
 
-  const bool use_mp =
-      (arma_config::openmp) &&
-      (eOp<T1, eop_type>::use_mp ||
-       (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (Proxy<T1>::use_at == false) {
     const uword n_elem = x.get_n_elem();
 
-    if (use_mp && mp_gate<eT>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class)) {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
 
       arma_applier_1_mp(-=);
@@ -386,7 +496,7 @@ inline void eop_core<eop_type>::apply_inplace_minus(Mat<typename T1::elem_type>&
   } else {
     const Proxy<T1>& P = x.P;
 
-    if (use_mp && mp_gate<eT>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost_class)) {
       arma_applier_2_mp(-=);
     } else {
       arma_applier_2(-=);
@@ -411,15 +521,13 @@ inline void eop_core<eop_type>::apply_inplace_schur(Mat<typename T1::elem_type>&
   const eT k = x.aux;
   eT* out_mem = out.memptr();
 
-  const bool use_mp =
-      (arma_config::openmp) &&
-      (eOp<T1, eop_type>::use_mp ||
-       (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (Proxy<T1>::use_at == false) {
     const uword n_elem = x.get_n_elem();
 
-    if (use_mp && mp_gate<eT>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class)) {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
 
       arma_applier_1_mp(*=);
@@ -445,7 +553,7 @@ inline void eop_core<eop_type>::apply_inplace_schur(Mat<typename T1::elem_type>&
   } else {
     const Proxy<T1>& P = x.P;
 
-    if (use_mp && mp_gate<eT>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost_class)) {
       arma_applier_2_mp(*=);
     } else {
       arma_applier_2(*=);
@@ -470,15 +578,13 @@ inline void eop_core<eop_type>::apply_inplace_div(Mat<typename T1::elem_type>& o
   const eT k = x.aux;
   eT* out_mem = out.memptr();
 
-  const bool use_mp =
-      (arma_config::openmp) &&
-      (eOp<T1, eop_type>::use_mp ||
-       (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (Proxy<T1>::use_at == false) {
     const uword n_elem = x.get_n_elem();
 
-    if (use_mp && mp_gate<eT>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class)) {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
 
       arma_applier_1_mp(/=);
@@ -504,7 +610,7 @@ inline void eop_core<eop_type>::apply_inplace_div(Mat<typename T1::elem_type>& o
   } else {
     const Proxy<T1>& P = x.P;
 
-    if (use_mp && mp_gate<eT>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost_class)) {
       arma_applier_2_mp(/=);
     } else {
       arma_applier_2(/=);
@@ -530,15 +636,13 @@ inline void eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out,
   const eT k = x.aux;
   eT* out_mem = out.memptr();
 
-  const bool use_mp =
-      (arma_config::openmp) &&
-      (eOpCube<T1, eop_type>::use_mp ||
-       (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (ProxyCube<T1>::use_at == false) {
     const uword n_elem = out.n_elem;
 
-    if (use_mp && mp_gate<eT>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class)) {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
 
       arma_applier_1_mp(=);
@@ -568,7 +672,7 @@ inline void eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out,
 
     const ProxyCube<T1>& P = x.P;
 
-    if (use_mp && mp_gate<eT>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost_class)) {
       arma_applier_3_mp(=);
     } else {
       arma_applier_3(=);
@@ -594,15 +698,13 @@ inline void eop_core<eop_type>::apply_inplace_plus(Cube<typename T1::elem_type>&
   const eT k = x.aux;
   eT* out_mem = out.memptr();
 
-  const bool use_mp =
-      (arma_config::openmp) &&
-      (eOpCube<T1, eop_type>::use_mp ||
-       (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (ProxyCube<T1>::use_at == false) {
     const uword n_elem = out.n_elem;
 
-    if (use_mp && mp_gate<eT>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class)) {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
 
       arma_applier_1_mp(+=);
@@ -628,7 +730,7 @@ inline void eop_core<eop_type>::apply_inplace_plus(Cube<typename T1::elem_type>&
   } else {
     const ProxyCube<T1>& P = x.P;
 
-    if (use_mp && mp_gate<eT>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost_class)) {
       arma_applier_3_mp(+=);
     } else {
       arma_applier_3(+=);
@@ -654,15 +756,13 @@ inline void eop_core<eop_type>::apply_inplace_minus(Cube<typename T1::elem_type>
   const eT k = x.aux;
   eT* out_mem = out.memptr();
 
-  const bool use_mp =
-      (arma_config::openmp) &&
-      (eOpCube<T1, eop_type>::use_mp ||
-       (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (ProxyCube<T1>::use_at == false) {
     const uword n_elem = out.n_elem;
 
-    if (use_mp && mp_gate<eT>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class)) {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
 
       arma_applier_1_mp(-=);
@@ -688,7 +788,7 @@ inline void eop_core<eop_type>::apply_inplace_minus(Cube<typename T1::elem_type>
   } else {
     const ProxyCube<T1>& P = x.P;
 
-    if (use_mp && mp_gate<eT>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost_class)) {
       arma_applier_3_mp(-=);
     } else {
       arma_applier_3(-=);
@@ -714,15 +814,13 @@ inline void eop_core<eop_type>::apply_inplace_schur(Cube<typename T1::elem_type>
   const eT k = x.aux;
   eT* out_mem = out.memptr();
 
-  const bool use_mp =
-      (arma_config::openmp) &&
-      (eOpCube<T1, eop_type>::use_mp ||
-       (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (ProxyCube<T1>::use_at == false) {
     const uword n_elem = out.n_elem;
 
-    if (use_mp && mp_gate<eT>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class)) {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
 
       arma_applier_1_mp(*=);
@@ -748,7 +846,7 @@ inline void eop_core<eop_type>::apply_inplace_schur(Cube<typename T1::elem_type>
   } else {
     const ProxyCube<T1>& P = x.P;
 
-    if (use_mp && mp_gate<eT>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost_class)) {
       arma_applier_3_mp(*=);
     } else {
       arma_applier_3(*=);
@@ -774,15 +872,13 @@ inline void eop_core<eop_type>::apply_inplace_div(Cube<typename T1::elem_type>&
   const eT k = x.aux;
   eT* out_mem = out.memptr();
 
-  const bool use_mp =
-      (arma_config::openmp) &&
-      (eOpCube<T1, eop_type>::use_mp ||
-       (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::openmp);
+  const int mp_cost_class = eop_mp_class(x);
 
   if (ProxyCube<T1>::use_at == false) {
     const uword n_elem = out.n_elem;
 
-    if (use_mp && mp_gate<eT>::eval(n_elem)) {
+    if (use_mp && mp_gate<eT>::eval_nested(n_elem, mp_cost_class)) {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
 
       arma_applier_1_mp(/=);
@@ -808,7 +904,7 @@ inline void eop_core<eop_type>::apply_inplace_div(Cube<typename T1::elem_type>&
   } else {
     const ProxyCube<T1>& P = x.P;
 
-    if (use_mp && mp_gate<eT>::eval(x.get_n_elem())) {
+    if (use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost_class)) {
       arma_applier_3_mp(/=);
     } else {
       arma_applier_3(/=);
@@ -30,22 +30,22 @@ arma_hot inline typename T1::elem_type accu_proxy_linear(const Proxy<T1>& P) {
 
   const uword n_elem = P.get_n_elem();
 
-  if (arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(n_elem)) {
+  if (arma_config::openmp && Proxy<T1>::use_mp &&
+      mp_gate<eT>::eval_nested(n_elem, mp_cost<T1>::value)) {
 #if defined(ARMA_USE_OPENMP)
     {
       // NOTE: using parallelisation with manual reduction workaround to take into account
       // complex numbers; NOTE: OpenMP versions lower than 4.0 do not support user-defined
       // reduction
 
-      const int n_threads_max = mp_thread_limit::get();
+      // Pacha: chunks run as tasks inside a parallel region (mp_chunks() in mp_misc.hpp)
       const uword n_threads_use =
-          (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
+          (std::min)(uword(podarray_prealloc_n_elem::val), mp_tasks::chunks());
       const uword chunk_size = n_elem / n_threads_use;
 
       podarray<eT> partial_accs(n_threads_use);
 
-#pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for (uword thread_id = 0; thread_id < n_threads_use; ++thread_id) {
+      mp_chunks(n_threads_use, [&](const uword thread_id) {
         const uword start = (thread_id + 0) * chunk_size;
         const uword endp1 = (thread_id + 1) * chunk_size;
 
@@ -55,7 +55,7 @@ arma_hot inline typename T1::elem_type accu_proxy_linear(const Proxy<T1>& P) {
         }
 
         partial_accs[thread_id] = acc;
-      }
+      });
 
       for (uword thread_id = 0; thread_id < n_threads_use; ++thread_id) {
         val += partial_accs[thread_id];
@@ -214,7 +214,8 @@ arma_hot inline typename T1::elem_type accu_proxy_at(const Proxy<T1>& P) {
 
   typedef typename T1::elem_type eT;
 
-  if (arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(P.get_n_elem())) {
+  if (arma_config::openmp && Proxy<T1>::use_mp &&
+      mp_gate<eT>::eval(P.get_n_elem(), mp_cost<T1>::value)) {
     return accu_proxy_at_mp(P);
   }
 
@@ -633,22 +634,22 @@ arma_hot inline typename T1::elem_type accu_cube_proxy_linear(const ProxyCube<T1
 
   const uword n_elem = P.get_n_elem();
 
-  if (arma_config::openmp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(n_elem)) {
+  if (arma_config::openmp && ProxyCube<T1>::use_mp &&
+      mp_gate<eT>::eval_nested(n_elem, mp_cost<T1>::value)) {
 #if defined(ARMA_USE_OPENMP)
     {
       // NOTE: using parallelisation with manual reduction workaround to take into account
       // complex numbers; NOTE: OpenMP versions lower than 4.0 do not support user-defined
       // reduction
 
-      const int n_threads_max = mp_thread_limit::get();
+      // Pacha: chunks run as tasks inside a parallel region (mp_chunks() in mp_misc.hpp)
       const uword n_threads_use =
-          (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
+          (std::min)(uword(podarray_prealloc_n_elem::val), mp_tasks::chunks());
       const uword chunk_size = n_elem / n_threads_use;
 
       podarray<eT> partial_accs(n_threads_use);
 
-#pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for (uword thread_id = 0; thread_id < n_threads_use; ++thread_id) {
+      mp_chunks(n_threads_use, [&](const uword thread_id) {
         const uword start = (thread_id + 0) * chunk_size;
         const uword endp1 = (thread_id + 1) * chunk_size;
 
@@ -658,7 +659,7 @@ arma_hot inline typename T1::elem_type accu_cube_proxy_linear(const ProxyCube<T1
         }
 
         partial_accs[thread_id] = acc;
-      }
+      });
 
       for (uword thread_id = 0; thread_id < n_threads_use; ++thread_id) {
         val += partial_accs[thread_id];
@@ -762,7 +763,8 @@ arma_hot inline typename T1::elem_type accu_cube_proxy_at(const ProxyCube<T1>& P
 
   typedef typename T1::elem_type eT;
 
-  if (arma_config::openmp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(P.get_n_elem())) {
+  if (arma_config::openmp && ProxyCube<T1>::use_mp &&
+      mp_gate<eT>::eval(P.get_n_elem(), mp_cost<T1>::value)) {
     return accu_cube_proxy_at_mp(P);
   }
 
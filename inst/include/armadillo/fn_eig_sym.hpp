@@ -24,6 +24,7 @@ inline typename enable_if2<is_supported_blas_type<typename T1::elem_type>::value
                            bool>::result
 eig_sym(Col<typename T1::pod_type>& eigval, const Base<typename T1::elem_type, T1>& X) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("eig_sym");
 
   typedef typename T1::elem_type eT;
 
@@ -46,6 +47,7 @@ arma_warn_unused inline
                         Col<typename T1::pod_type> >::result
     eig_sym(const Base<typename T1::elem_type, T1>& X) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("eig_sym");
 
   typedef typename T1::elem_type eT;
   typedef typename T1::pod_type T;
@@ -99,6 +101,7 @@ inline typename enable_if2<is_supported_blas_type<typename T1::elem_type>::value
 eig_sym(Col<typename T1::pod_type>& eigval, Mat<typename T1::elem_type>& eigvec,
         const Base<typename T1::elem_type, T1>& expr, const char* method = "dc") {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("eig_sym");
 
   typedef typename T1::elem_type eT;
 
@@ -59,6 +59,13 @@ log_normpdf_helper(Mat<typename T1::elem_type>& out,
 
   const bool use_mp = arma_config::openmp && mp_gate<eT, true>::eval(N);
 
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+  // Pacha: fused SIMD kernel (fn_normpdf.hpp)
+  if (normal_simd_apply(SimdKernels::log_normpdf, out_mem, X_ea, M_ea, S_ea, N, use_mp)) {
+    return;
+  }
+#endif
+
   if (use_mp) {
 #if defined(ARMA_USE_OPENMP)
     {
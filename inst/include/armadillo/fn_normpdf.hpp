@@ -18,6 +18,82 @@
 //! \addtogroup fn_normpdf
 //! @{
 
+// Pacha: fused SIMD kernels for normpdf(), log_normpdf() and normcdf() (r_simd.hpp),
+// used in the fast accuracy mode. A mu or sigma that is the same for all elements
+// (the generators passed by the overloads with scalars) is given to the kernel as a
+// scalar instead of being evaluated element by element.
+
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+
+inline bool normal_simd_arg(const double* mem, const double*& p, double&) {
+  p = mem;
+  return true;
+}
+
+inline bool normal_simd_arg(const Gen<Mat<double>, gen_zeros>&, const double*& p,
+                            double& k) {
+  p = nullptr;
+  k = 0.0;
+  return true;
+}
+
+inline bool normal_simd_arg(const Gen<Mat<double>, gen_ones>&, const double*& p,
+                            double& k) {
+  p = nullptr;
+  k = 1.0;
+  return true;
+}
+
+inline bool normal_simd_arg(const eOp<Gen<Mat<double>, gen_ones>, eop_scalar_times>& x,
+                            const double*& p, double& k) {
+  p = nullptr;
+  k = x.aux;
+  return true;
+}
+
+template <typename ea_type>
+inline bool normal_simd_arg(const ea_type&, const double*&, double&) {
+  return false;
+}
+
+template <typename ea_type1, typename ea_type2, typename ea_type3>
+inline bool normal_simd_apply(const int op, double* out, const ea_type1& X,
+                              const ea_type2& M, const ea_type3& S, const uword N,
+                              const bool use_mp) {
+  if (Simd::fast_math() == false) {
+    return false;
+  }
+
+  const double* x = nullptr;
+  const double* mu = nullptr;
+  const double* sigma = nullptr;
+  double x_k = 0.0;
+  double mu_k = 0.0;
+  double sigma_k = 1.0;
+
+  if (normal_simd_arg(X, x, x_k) == false || x == nullptr ||
+      normal_simd_arg(M, mu, mu_k) == false || normal_simd_arg(S, sigma, sigma_k) == false) {
+    return false;
+  }
+
+  const SimdKernels::normal_fn f = Simd::kernels().normal[op];
+
+  simd_run(N, use_mp, [&](const uword i, const uword n) {
+    f(out + i, x + i, (mu != nullptr) ? mu + i : nullptr,
+      (sigma != nullptr) ? sigma + i : nullptr, mu_k, sigma_k, n);
+  });
+
+  return true;
+}
+
+template <typename eT, typename ea_type1, typename ea_type2, typename ea_type3>
+inline bool normal_simd_apply(const int, eT*, const ea_type1&, const ea_type2&,
+                              const ea_type3&, const uword, const bool) {
+  return false;
+}
+
+#endif
+
 template <typename T1, typename T2, typename T3>
 inline typename enable_if2<(is_real<typename T1::elem_type>::value), void>::result
 normpdf_helper(Mat<typename T1::elem_type>& out,
@@ -59,6 +135,13 @@ normpdf_helper(Mat<typename T1::elem_type>& out,
 
   const bool use_mp = arma_config::openmp && mp_gate<eT, true>::eval(N);
 
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+  // Pacha: fused SIMD kernel (fn_normpdf.hpp)
+  if (normal_simd_apply(SimdKernels::normpdf, out_mem, X_ea, M_ea, S_ea, N, use_mp)) {
+    return;
+  }
+#endif
+
   if (use_mp) {
 #if defined(ARMA_USE_OPENMP)
     {
@@ -60,7 +60,7 @@ inline void glue_powext::apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B)
   const eT* A_mem = A.memptr();
   const eT* B_mem = B.memptr();
 
-  if (arma_config::openmp && mp_gate<eT>::eval(N)) {
+  if (arma_config::openmp && mp_gate<eT>::eval(N, ::Parallel::expensive)) {
 #if defined(ARMA_USE_OPENMP)
     {
       const int n_threads = mp_thread_limit::get();
@@ -101,7 +101,7 @@ inline Mat<typename parent::elem_type> glue_powext::apply(
 
   if (mode == 0)  // each column
   {
-    if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem)) {
+    if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem, ::Parallel::expensive)) {
 #if defined(ARMA_USE_OPENMP)
       {
         const int n_threads = int((std::min)(uword(mp_thread_limit::get()), A_n_cols));
@@ -131,7 +131,7 @@ inline Mat<typename parent::elem_type> glue_powext::apply(
 
   if (mode == 1)  // each row
   {
-    if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem)) {
+    if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem, ::Parallel::expensive)) {
 #if defined(ARMA_USE_OPENMP)
       {
         const int n_threads = int((std::min)(uword(mp_thread_limit::get()), A_n_cols));
@@ -204,7 +204,7 @@ inline void glue_powext::apply(Cube<eT>& out, const Cube<eT>& A, const Cube<eT>&
   const eT* A_mem = A.memptr();
   const eT* B_mem = B.memptr();
 
-  if (arma_config::openmp && mp_gate<eT>::eval(N)) {
+  if (arma_config::openmp && mp_gate<eT>::eval(N, ::Parallel::expensive)) {
 #if defined(ARMA_USE_OPENMP)
     {
       const int n_threads = mp_thread_limit::get();
@@ -243,7 +243,7 @@ inline Cube<eT> glue_powext::apply(const subview_cube_each1<eT>& X,
   const eT* B_mem = B.memptr();
   const uword B_n_elem = B.n_elem;
 
-  if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem)) {
+  if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem, ::Parallel::expensive)) {
 #if defined(ARMA_USE_OPENMP)
     {
       const int n_threads = int((std::min)(uword(mp_thread_limit::get()), A_n_slices));
@@ -318,7 +318,7 @@ inline void glue_powext_cx::apply(Mat<std::complex<T> >& out,
   const eT* A_mem = A.memptr();
   const T* B_mem = B.memptr();
 
-  if (arma_config::openmp && mp_gate<eT>::eval(N)) {
+  if (arma_config::openmp && mp_gate<eT>::eval(N, ::Parallel::expensive)) {
 #if defined(ARMA_USE_OPENMP)
     {
       const int n_threads = mp_thread_limit::get();
@@ -360,7 +360,7 @@ inline Mat<typename parent::elem_type> glue_powext_cx::apply(
 
   if (mode == 0)  // each column
   {
-    if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem)) {
+    if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem, ::Parallel::expensive)) {
 #if defined(ARMA_USE_OPENMP)
       {
         const int n_threads = int((std::min)(uword(mp_thread_limit::get()), A_n_cols));
@@ -390,7 +390,7 @@ inline Mat<typename parent::elem_type> glue_powext_cx::apply(
 
   if (mode == 1)  // each row
   {
-    if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem)) {
+    if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem, ::Parallel::expensive)) {
 #if defined(ARMA_USE_OPENMP)
       {
         const int n_threads = int((std::min)(uword(mp_thread_limit::get()), A_n_cols));
@@ -461,7 +461,7 @@ inline void glue_powext_cx::apply(Cube<std::complex<T> >& out,
   const eT* A_mem = A.memptr();
   const T* B_mem = B.memptr();
 
-  if (arma_config::openmp && mp_gate<eT>::eval(N)) {
+  if (arma_config::openmp && mp_gate<eT>::eval(N, ::Parallel::expensive)) {
 #if defined(ARMA_USE_OPENMP)
     {
       const int n_threads = mp_thread_limit::get();
@@ -502,7 +502,7 @@ inline Cube<std::complex<T> > glue_powext_cx::apply(
   const T* B_mem = B.memptr();
   const uword B_n_elem = B.n_elem;
 
-  if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem)) {
+  if (arma_config::openmp && mp_gate<eT>::eval(A.n_elem, ::Parallel::expensive)) {
 #if defined(ARMA_USE_OPENMP)
     {
       const int n_threads = int((std::min)(uword(mp_thread_limit::get()), A_n_slices));
@@ -50,8 +50,10 @@
                                                                                         \
         const uword n_elem = out.n_elem;                                                \
                                                                                         \
-        for (uword i = 0; i < n_elem; ++i) {                                            \
-          out_mem[i] = (A[i] operator_rel B[i]) ? uword(1) : uword(0);                  \
+        if (glue_rel_simd_apply(out_mem, A, B, n_elem, X) == false) {                   \
+          for (uword i = 0; i < n_elem; ++i) {                                          \
+            out_mem[i] = (A[i] operator_rel B[i]) ? uword(1) : uword(0);                \
+          }                                                                             \
         }                                                                               \
       } else {                                                                          \
         if (n_rows == 1) {                                                              \
@@ -103,8 +105,10 @@
                                                                                       \
         const uword n_elem = out.n_elem;                                              \
                                                                                       \
-        for (uword i = 0; i < n_elem; ++i) {                                          \
-          out_mem[i] = (A[i] operator_rel B[i]) ? uword(1) : uword(0);                \
+        if (glue_rel_simd_apply(out_mem, A, B, n_elem, X) == false) {                 \
+          for (uword i = 0; i < n_elem; ++i) {                                        \
+            out_mem[i] = (A[i] operator_rel B[i]) ? uword(1) : uword(0);              \
+          }                                                                           \
         }                                                                             \
       } else {                                                                        \
         for (uword slice = 0; slice < n_slices; ++slice)                              \
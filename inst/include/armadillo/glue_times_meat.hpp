@@ -457,6 +457,7 @@ template <typename T1, typename T2>
 inline void glue_times::apply(Mat<typename T1::elem_type>& out,
                               const Glue<T1, T2, glue_times>& X) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("glue_times::apply");
 
   constexpr uword N_mat = 1 + depth_lhs<glue_times, Glue<T1, T2, glue_times> >::num;
 
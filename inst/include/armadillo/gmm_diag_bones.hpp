@@ -186,7 +186,7 @@ class gmm_diag {
   inline bool em_iterate(const Mat<eT>& X, const uword max_iter, const eT var_floor,
                          const bool verbose);
 
-  inline void em_update_params(const Mat<eT>& X, const umat& boundaries,
+  inline bool em_update_params(const Mat<eT>& X, const umat& boundaries,
                                field<Mat<eT> >& t_acc_means, field<Mat<eT> >& t_acc_dcovs,
                                field<Col<eT> >& t_acc_norm_lhoods,
                                field<Col<eT> >& t_gaus_log_lhoods,
@@ -901,8 +901,10 @@ inline umat gmm_diag<eT>::internal_gen_boundaries(const uword N) const {
   arma_debug_sigprint();
 
 #if defined(ARMA_USE_OPENMP)
-  const uword n_threads_avail =
-      (omp_in_parallel()) ? uword(1) : uword(omp_get_max_threads());
+  // Pacha: thread budget (r_parallel.hpp) instead of omp_get_max_threads(), and
+  // several chunks per thread inside a parallel region, where the loops below run as
+  // OpenMP tasks (mp_chunks() in mp_misc.hpp)
+  const uword n_threads_avail = mp_tasks::chunks();
   const uword n_threads =
       (n_threads_avail > 0) ? ((n_threads_avail <= N) ? n_threads_avail : 1) : 1;
 #else
@@ -1013,8 +1015,7 @@ inline Row<eT> gmm_diag<eT>::internal_vec_log_p(const Mat<eT>& X) const {
 
       const uword n_threads = boundaries.n_cols;
 
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         const uword start_index = boundaries.at(0, t);
         const uword end_index = boundaries.at(1, t);
 
@@ -1023,7 +1024,7 @@ inline Row<eT> gmm_diag<eT>::internal_vec_log_p(const Mat<eT>& X) const {
         for (uword i = start_index; i <= end_index; ++i) {
           out_mem[i] = internal_scalar_log_p(X.colptr(i));
         }
-      }
+      });
     }
 #else
     {
@@ -1060,8 +1061,7 @@ inline Row<eT> gmm_diag<eT>::internal_vec_log_p(const Mat<eT>& X,
 
       const uword n_threads = boundaries.n_cols;
 
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         const uword start_index = boundaries.at(0, t);
         const uword end_index = boundaries.at(1, t);
 
@@ -1070,7 +1070,7 @@ inline Row<eT> gmm_diag<eT>::internal_vec_log_p(const Mat<eT>& X,
         for (uword i = start_index; i <= end_index; ++i) {
           out_mem[i] = internal_scalar_log_p(X.colptr(i), gaus_id);
         }
-      }
+      });
     }
 #else
     {
@@ -1107,8 +1107,7 @@ inline eT gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X) const {
 
     Col<eT> t_accs(n_threads, arma_zeros_indicator());
 
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; ++t) {
+    mp_chunks(n_threads, [&](const uword t) {
       const uword start_index = boundaries.at(0, t);
       const uword end_index = boundaries.at(1, t);
 
@@ -1119,7 +1118,7 @@ inline eT gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X) const {
       }
 
       t_accs[t] = t_acc;
-    }
+    });
 
     return eT(accu(t_accs));
   }
@@ -1159,8 +1158,7 @@ inline eT gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id
 
     Col<eT> t_accs(n_threads, arma_zeros_indicator());
 
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; ++t) {
+    mp_chunks(n_threads, [&](const uword t) {
       const uword start_index = boundaries.at(0, t);
       const uword end_index = boundaries.at(1, t);
 
@@ -1171,7 +1169,7 @@ inline eT gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id
       }
 
       t_accs[t] = t_acc;
-    }
+    });
 
     return eT(accu(t_accs));
   }
@@ -1209,8 +1207,7 @@ inline eT gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X) const {
 
     field<running_mean_scalar<eT> > t_running_means(n_threads);
 
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; ++t) {
+    mp_chunks(n_threads, [&](const uword t) {
       const uword start_index = boundaries.at(0, t);
       const uword end_index = boundaries.at(1, t);
 
@@ -1219,7 +1216,7 @@ inline eT gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X) const {
       for (uword i = start_index; i <= end_index; ++i) {
         current_running_mean(internal_scalar_log_p(X.colptr(i)));
       }
-    }
+    });
 
     eT avg = eT(0);
 
@@ -1269,8 +1266,7 @@ inline eT gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id
 
     field<running_mean_scalar<eT> > t_running_means(n_threads);
 
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; ++t) {
+    mp_chunks(n_threads, [&](const uword t) {
       const uword start_index = boundaries.at(0, t);
       const uword end_index = boundaries.at(1, t);
 
@@ -1279,7 +1275,7 @@ inline eT gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id
       for (uword i = start_index; i <= end_index; ++i) {
         current_running_mean(internal_scalar_log_p(X.colptr(i), gaus_id));
       }
-    }
+    });
 
     eT avg = eT(0);
 
@@ -1375,7 +1371,7 @@ inline void gmm_diag<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X,
   if (dist_mode == eucl_dist) {
 #if defined(ARMA_USE_OPENMP)
     {
-#pragma omp parallel for schedule(static)
+#pragma omp parallel for schedule(static) num_threads(mp_thread_limit::get())
       for (uword i = 0; i < X_n_cols; ++i) {
         const eT* X_colptr = X.colptr(i);
 
@@ -1422,7 +1418,7 @@ inline void gmm_diag<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X,
     {
       const eT* log_hefts_mem = log_hefts.memptr();
 
-#pragma omp parallel for schedule(static)
+#pragma omp parallel for schedule(static) num_threads(mp_thread_limit::get())
       for (uword i = 0; i < X_n_cols; ++i) {
         const eT* X_colptr = X.colptr(i);
 
@@ -1498,8 +1494,7 @@ inline void gmm_diag<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X,
     }
 
     if (dist_mode == eucl_dist) {
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         uword* thread_hist_mem = thread_hist(t).memptr();
 
         const uword start_index = boundaries.at(0, t);
@@ -1523,12 +1518,11 @@ inline void gmm_diag<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X,
 
           thread_hist_mem[best_g]++;
         }
-      }
+      });
     } else if (dist_mode == prob_dist) {
       const eT* log_hefts_mem = log_hefts.memptr();
 
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         uword* thread_hist_mem = thread_hist(t).memptr();
 
         const uword start_index = boundaries.at(0, t);
@@ -1551,7 +1545,7 @@ inline void gmm_diag<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X,
 
           thread_hist_mem[best_g]++;
         }
-      }
+      });
     }
 
     // reduction
@@ -1749,8 +1743,7 @@ inline void gmm_diag<eT>::generate_initial_params(const Mat<eT>& X, const eT var
       t_acc_hefts(t).zeros(N_gaus);
     }
 
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; ++t) {
+    mp_chunks(n_threads, [&](const uword t) {
       uword* t_acc_hefts_mem = t_acc_hefts(t).memptr();
 
       const uword start_index = boundaries.at(0, t);
@@ -1784,7 +1777,7 @@ inline void gmm_diag<eT>::generate_initial_params(const Mat<eT>& X, const eT var
 
         t_acc_hefts_mem[best_g]++;
       }
-    }
+    });
 
     // reduction
     acc_means = t_acc_means(0);
@@ -1916,8 +1909,7 @@ inline bool gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter,
         t_last_indx(t).zeros(N_gaus);
       }
 
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         Mat<eT>& t_acc_means_t = t_acc_means(t);
         uword* t_acc_hefts_mem = t_acc_hefts(t).memptr();
         uword* t_last_indx_mem = t_last_indx(t).memptr();
@@ -1926,6 +1918,10 @@ inline bool gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter,
         const uword end_index = boundaries.at(1, t);
 
         for (uword i = start_index; i <= end_index; ++i) {
+          if (ARMA_INTERRUPT_REQUESTED()) {
+            break;
+          }
+
           const eT* X_colptr = X.colptr(i);
 
           eT min_dist = Datum<eT>::inf;
@@ -1950,7 +1946,7 @@ inline bool gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter,
           t_acc_hefts_mem[best_g]++;
           t_last_indx_mem[best_g] = i;
         }
-      }
+      });
 
       // reduction
 
@@ -1979,6 +1975,10 @@ inline bool gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter,
       uword* last_indx_mem = last_indx.memptr();
 
       for (uword i = 0; i < X_n_cols; ++i) {
+        if (ARMA_INTERRUPT_REQUESTED()) {
+          break;
+        }
+
         const eT* X_colptr = X.colptr(i);
 
         eT min_dist = Datum<eT>::inf;
@@ -2006,6 +2006,11 @@ inline bool gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter,
     }
 #endif
 
+    // partial accumulators are discarded when the computation was cancelled
+    if (ARMA_CHECK_INTERRUPT()) {
+      return false;
+    }
+
     // generate new means
 
     uword* acc_hefts_mem = acc_hefts.memptr();
@@ -2157,8 +2162,10 @@ inline bool gmm_diag<eT>::em_iterate(const Mat<eT>& X, const uword max_iter,
   for (uword iter = 1; iter <= max_iter; ++iter) {
     init_constants();
 
-    em_update_params(X, boundaries, t_acc_means, t_acc_dcovs, t_acc_norm_lhoods,
-                     t_gaus_log_lhoods, t_progress_log_lhood);
+    if (em_update_params(X, boundaries, t_acc_means, t_acc_dcovs, t_acc_norm_lhoods,
+                         t_gaus_log_lhoods, t_progress_log_lhood) == false) {
+      return false;
+    }
 
     em_fix_params(var_floor);
 
@@ -2205,7 +2212,7 @@ inline bool gmm_diag<eT>::em_iterate(const Mat<eT>& X, const uword max_iter,
 }
 
 template <typename eT>
-inline void gmm_diag<eT>::em_update_params(const Mat<eT>& X, const umat& boundaries,
+inline bool gmm_diag<eT>::em_update_params(const Mat<eT>& X, const umat& boundaries,
                                            field<Mat<eT> >& t_acc_means,
                                            field<Mat<eT> >& t_acc_dcovs,
                                            field<Col<eT> >& t_acc_norm_lhoods,
@@ -2220,8 +2227,7 @@ inline void gmm_diag<eT>::em_update_params(const Mat<eT>& X, const umat& boundar
 
 #if defined(ARMA_USE_OPENMP)
   {
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; t++) {
+    mp_chunks(n_threads, [&](const uword t) {
       Mat<eT>& acc_means = t_acc_means[t];
       Mat<eT>& acc_dcovs = t_acc_dcovs[t];
       Col<eT>& acc_norm_lhoods = t_acc_norm_lhoods[t];
@@ -2230,7 +2236,7 @@ inline void gmm_diag<eT>::em_update_params(const Mat<eT>& X, const umat& boundar
 
       em_generate_acc(X, boundaries.at(0, t), boundaries.at(1, t), acc_means, acc_dcovs,
                       acc_norm_lhoods, gaus_log_lhoods, progress_log_lhood);
-    }
+    });
   }
 #else
   {
@@ -2240,6 +2246,12 @@ inline void gmm_diag<eT>::em_update_params(const Mat<eT>& X, const umat& boundar
   }
 #endif
 
+  // Pacha: partial accumulators are discarded when the computation was cancelled, the
+  // parameters are left as they were
+  if (ARMA_CHECK_INTERRUPT()) {
+    return false;
+  }
+
   const uword N_dims = means.n_rows;
   const uword N_gaus = means.n_cols;
 
@@ -2322,6 +2334,8 @@ inline void gmm_diag<eT>::em_update_params(const Mat<eT>& X, const umat& boundar
       }
     }
   }
+
+  return true;
 }
 
 template <typename eT>
@@ -2347,6 +2361,10 @@ inline void gmm_diag<eT>::em_generate_acc(const Mat<eT>& X, const uword start_in
   eT* gaus_log_lhoods_mem = gaus_log_lhoods.memptr();
 
   for (uword i = start_index; i <= end_index; i++) {
+    if (ARMA_INTERRUPT_REQUESTED()) {
+      break;
+    }
+
     const eT* x = X.colptr(i);
 
     for (uword g = 0; g < N_gaus; ++g) {
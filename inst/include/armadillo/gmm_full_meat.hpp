@@ -910,7 +910,10 @@ inline umat gmm_full<eT>::internal_gen_boundaries(const uword N) const {
   arma_debug_sigprint();
 
 #if defined(ARMA_USE_OPENMP)
-  const uword n_threads_avail = uword(omp_get_max_threads());
+  // Pacha: thread budget (r_parallel.hpp) instead of omp_get_max_threads(), and
+  // several chunks per thread inside a parallel region, where the loops below run as
+  // OpenMP tasks (mp_chunks() in mp_misc.hpp)
+  const uword n_threads_avail = mp_tasks::chunks();
   const uword n_threads =
       (n_threads_avail > 0) ? ((n_threads_avail <= N) ? n_threads_avail : 1) : 1;
 #else
@@ -1013,8 +1016,7 @@ inline Row<eT> gmm_full<eT>::internal_vec_log_p(const Mat<eT>& X) const {
 
       const uword n_threads = boundaries.n_cols;
 
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         const uword start_index = boundaries.at(0, t);
         const uword end_index = boundaries.at(1, t);
 
@@ -1023,7 +1025,7 @@ inline Row<eT> gmm_full<eT>::internal_vec_log_p(const Mat<eT>& X) const {
         for (uword i = start_index; i <= end_index; ++i) {
           out_mem[i] = internal_scalar_log_p(X.colptr(i));
         }
-      }
+      });
     }
 #else
     {
@@ -1060,8 +1062,7 @@ inline Row<eT> gmm_full<eT>::internal_vec_log_p(const Mat<eT>& X,
 
       const uword n_threads = boundaries.n_cols;
 
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         const uword start_index = boundaries.at(0, t);
         const uword end_index = boundaries.at(1, t);
 
@@ -1070,7 +1071,7 @@ inline Row<eT> gmm_full<eT>::internal_vec_log_p(const Mat<eT>& X,
         for (uword i = start_index; i <= end_index; ++i) {
           out_mem[i] = internal_scalar_log_p(X.colptr(i), gaus_id);
         }
-      }
+      });
     }
 #else
     {
@@ -1107,8 +1108,7 @@ inline eT gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X) const {
 
     Col<eT> t_accs(n_threads, arma_zeros_indicator());
 
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; ++t) {
+    mp_chunks(n_threads, [&](const uword t) {
       const uword start_index = boundaries.at(0, t);
       const uword end_index = boundaries.at(1, t);
 
@@ -1119,7 +1119,7 @@ inline eT gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X) const {
       }
 
       t_accs[t] = t_acc;
-    }
+    });
 
     return eT(accu(t_accs));
   }
@@ -1159,8 +1159,7 @@ inline eT gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id
 
     Col<eT> t_accs(n_threads, arma_zeros_indicator());
 
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; ++t) {
+    mp_chunks(n_threads, [&](const uword t) {
       const uword start_index = boundaries.at(0, t);
       const uword end_index = boundaries.at(1, t);
 
@@ -1171,7 +1170,7 @@ inline eT gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id
       }
 
       t_accs[t] = t_acc;
-    }
+    });
 
     return eT(accu(t_accs));
   }
@@ -1210,8 +1209,7 @@ inline eT gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X) const {
 
     field<running_mean_scalar<eT> > t_running_means(n_threads);
 
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; ++t) {
+    mp_chunks(n_threads, [&](const uword t) {
       const uword start_index = boundaries.at(0, t);
       const uword end_index = boundaries.at(1, t);
 
@@ -1220,7 +1218,7 @@ inline eT gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X) const {
       for (uword i = start_index; i <= end_index; ++i) {
         current_running_mean(internal_scalar_log_p(X.colptr(i)));
       }
-    }
+    });
 
     eT avg = eT(0);
 
@@ -1271,8 +1269,7 @@ inline eT gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id
 
     field<running_mean_scalar<eT> > t_running_means(n_threads);
 
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; ++t) {
+    mp_chunks(n_threads, [&](const uword t) {
       const uword start_index = boundaries.at(0, t);
       const uword end_index = boundaries.at(1, t);
 
@@ -1281,7 +1278,7 @@ inline eT gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id
       for (uword i = start_index; i <= end_index; ++i) {
         current_running_mean(internal_scalar_log_p(X.colptr(i), gaus_id));
       }
-    }
+    });
 
     eT avg = eT(0);
 
@@ -1377,7 +1374,7 @@ inline void gmm_full<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X,
   if (dist_mode == eucl_dist) {
 #if defined(ARMA_USE_OPENMP)
     {
-#pragma omp parallel for schedule(static)
+#pragma omp parallel for schedule(static) num_threads(mp_thread_limit::get())
       for (uword i = 0; i < X_n_cols; ++i) {
         const eT* X_colptr = X.colptr(i);
 
@@ -1428,8 +1425,7 @@ inline void gmm_full<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X,
 
       const eT* log_hefts_mem = log_hefts.memptr();
 
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         const uword start_index = boundaries.at(0, t);
         const uword end_index = boundaries.at(1, t);
 
@@ -1450,7 +1446,7 @@ inline void gmm_full<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X,
 
           out_mem[i] = best_g;
         }
-      }
+      });
     }
 #else
     {
@@ -1509,8 +1505,7 @@ inline void gmm_full<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X,
     }
 
     if (dist_mode == eucl_dist) {
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         uword* thread_hist_mem = thread_hist(t).memptr();
 
         const uword start_index = boundaries.at(0, t);
@@ -1534,12 +1529,11 @@ inline void gmm_full<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X,
 
           thread_hist_mem[best_g]++;
         }
-      }
+      });
     } else if (dist_mode == prob_dist) {
       const eT* log_hefts_mem = log_hefts.memptr();
 
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         uword* thread_hist_mem = thread_hist(t).memptr();
 
         const uword start_index = boundaries.at(0, t);
@@ -1562,7 +1556,7 @@ inline void gmm_full<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X,
 
           thread_hist_mem[best_g]++;
         }
-      }
+      });
     }
 
     // reduction
@@ -1758,8 +1752,7 @@ inline void gmm_full<eT>::generate_initial_params(const Mat<eT>& X, const eT var
       t_acc_hefts(t).zeros(N_gaus);
     }
 
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; ++t) {
+    mp_chunks(n_threads, [&](const uword t) {
       uword* t_acc_hefts_mem = t_acc_hefts(t).memptr();
 
       const uword start_index = boundaries.at(0, t);
@@ -1793,7 +1786,7 @@ inline void gmm_full<eT>::generate_initial_params(const Mat<eT>& X, const eT var
 
         t_acc_hefts_mem[best_g]++;
       }
-    }
+    });
 
     // reduction
     acc_means = t_acc_means(0);
@@ -1927,8 +1920,7 @@ inline bool gmm_full<eT>::km_iterate(const Mat<eT>& X, const uword max_iter,
         t_last_indx(t).zeros(N_gaus);
       }
 
-#pragma omp parallel for schedule(static)
-      for (uword t = 0; t < n_threads; ++t) {
+      mp_chunks(n_threads, [&](const uword t) {
         Mat<eT>& t_acc_means_t = t_acc_means(t);
         uword* t_acc_hefts_mem = t_acc_hefts(t).memptr();
         uword* t_last_indx_mem = t_last_indx(t).memptr();
@@ -1937,6 +1929,10 @@ inline bool gmm_full<eT>::km_iterate(const Mat<eT>& X, const uword max_iter,
         const uword end_index = boundaries.at(1, t);
 
         for (uword i = start_index; i <= end_index; ++i) {
+          if (ARMA_INTERRUPT_REQUESTED()) {
+            break;
+          }
+
           const eT* X_colptr = X.colptr(i);
 
           eT min_dist = Datum<eT>::inf;
@@ -1961,7 +1957,7 @@ inline bool gmm_full<eT>::km_iterate(const Mat<eT>& X, const uword max_iter,
           t_acc_hefts_mem[best_g]++;
           t_last_indx_mem[best_g] = i;
         }
-      }
+      });
 
       // reduction
 
@@ -1990,6 +1986,10 @@ inline bool gmm_full<eT>::km_iterate(const Mat<eT>& X, const uword max_iter,
       uword* last_indx_mem = last_indx.memptr();
 
       for (uword i = 0; i < X_n_cols; ++i) {
+        if (ARMA_INTERRUPT_REQUESTED()) {
+          break;
+        }
+
         const eT* X_colptr = X.colptr(i);
 
         eT min_dist = Datum<eT>::inf;
@@ -2017,6 +2017,11 @@ inline bool gmm_full<eT>::km_iterate(const Mat<eT>& X, const uword max_iter,
     }
 #endif
 
+    // partial accumulators are discarded when the computation was cancelled
+    if (ARMA_CHECK_INTERRUPT()) {
+      return false;
+    }
+
     // generate new means
 
     uword* acc_hefts_mem = acc_hefts.memptr();
@@ -2166,8 +2171,10 @@ inline bool gmm_full<eT>::em_iterate(const Mat<eT>& X, const uword max_iter,
   for (uword iter = 1; iter <= max_iter; ++iter) {
     init_constants(calc_chol);
 
-    em_update_params(X, boundaries, t_acc_means, t_acc_fcovs, t_acc_norm_lhoods,
-                     t_gaus_log_lhoods, t_progress_log_lhood, var_floor);
+    if (em_update_params(X, boundaries, t_acc_means, t_acc_fcovs, t_acc_norm_lhoods,
+                         t_gaus_log_lhoods, t_progress_log_lhood, var_floor) == false) {
+      return false;
+    }
 
     em_fix_params(var_floor);
 
@@ -2219,7 +2226,7 @@ inline bool gmm_full<eT>::em_iterate(const Mat<eT>& X, const uword max_iter,
 }
 
 template <typename eT>
-inline void gmm_full<eT>::em_update_params(const Mat<eT>& X, const umat& boundaries,
+inline bool gmm_full<eT>::em_update_params(const Mat<eT>& X, const umat& boundaries,
                                            field<Mat<eT> >& t_acc_means,
                                            field<Cube<eT> >& t_acc_fcovs,
                                            field<Col<eT> >& t_acc_norm_lhoods,
@@ -2235,8 +2242,7 @@ inline void gmm_full<eT>::em_update_params(const Mat<eT>& X, const umat& boundar
 
 #if defined(ARMA_USE_OPENMP)
   {
-#pragma omp parallel for schedule(static)
-    for (uword t = 0; t < n_threads; t++) {
+    mp_chunks(n_threads, [&](const uword t) {
       Mat<eT>& acc_means = t_acc_means[t];
       Cube<eT>& acc_fcovs = t_acc_fcovs[t];
       Col<eT>& acc_norm_lhoods = t_acc_norm_lhoods[t];
@@ -2245,7 +2251,7 @@ inline void gmm_full<eT>::em_update_params(const Mat<eT>& X, const umat& boundar
 
       em_generate_acc(X, boundaries.at(0, t), boundaries.at(1, t), acc_means, acc_fcovs,
                       acc_norm_lhoods, gaus_log_lhoods, progress_log_lhood);
-    }
+    });
   }
 #else
   {
@@ -2255,6 +2261,12 @@ inline void gmm_full<eT>::em_update_params(const Mat<eT>& X, const umat& boundar
   }
 #endif
 
+  // Pacha: partial accumulators are discarded when the computation was cancelled, the
+  // parameters are left as they were
+  if (ARMA_CHECK_INTERRUPT()) {
+    return false;
+  }
+
   const uword N_dims = means.n_rows;
   const uword N_gaus = means.n_cols;
 
@@ -2366,6 +2378,8 @@ inline void gmm_full<eT>::em_update_params(const Mat<eT>& X, const umat& boundar
       fcov = acc_fcov;
     }
   }
+
+  return true;
 }
 
 template <typename eT>
@@ -2391,6 +2405,10 @@ inline void gmm_full<eT>::em_generate_acc(const Mat<eT>& X, const uword start_in
   eT* gaus_log_lhoods_mem = gaus_log_lhoods.memptr();
 
   for (uword i = start_index; i <= end_index; i++) {
+    if (ARMA_INTERRUPT_REQUESTED()) {
+      break;
+    }
+
     const eT* x = X.colptr(i);
 
     for (uword g = 0; g < N_gaus; ++g) {
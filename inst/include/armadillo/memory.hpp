@@ -62,15 +62,44 @@ arma_malloc inline eT* memory::acquire(const uword n_elem) {
     eT* memptr = nullptr;
 
     const size_t n_bytes = sizeof(eT) * size_t(n_elem);
-    const size_t alignment = (n_bytes >= size_t(1024)) ? size_t(32) : size_t(16);
+    size_t alignment = (n_bytes >= size_t(1024)) ? size_t(32) : size_t(16);
+
+    // Pacha: optional 64 byte alignment (a cache line, or an AVX-512 register) and
+    // transparent huge pages for large blocks, see config.hpp
+
+#if defined(CPP11ARMADILLO_USE_ALIGN64)
+    if (n_bytes >= size_t(CPP11ARMADILLO_ALIGN64_THRESHOLD)) {
+      alignment = size_t(64);
+    }
+#endif
+
+#if defined(CPP11ARMADILLO_USE_HUGEPAGES)
+    const bool huge_pages = (n_bytes >= size_t(CPP11ARMADILLO_HUGEPAGE_THRESHOLD));
 
-    // TODO: investigate apparent memory leak when using alignment >= 64 (as shown on
-    // Fedora 28, glibc 2.27)
+    if (huge_pages) {
+      alignment = size_t(2097152);
+    }
+#endif
+
+    // Pacha: Armadillo had a TODO here about an apparent memory leak with alignment
+    // >= 64 (Fedora 28, glibc 2.27), which is why its default stays at 16/32 bytes.
+    // The 64 byte and 2 MB modes are opt-in: allocating and releasing 64 byte aligned
+    // blocks keeps a constant heap size with glibc 2.36, and blocks aligned to 2 MB
+    // (32 MB or more by default) are served by mmap() and unmapped when released. A
+    // CPP11ARMADILLO_HUGEPAGE_THRESHOLD below 32 MB can leave up to 2 MB of padding
+    // per block in the heap.
     int status = posix_memalign(
         (void**)&memptr, ((alignment >= sizeof(void*)) ? alignment : sizeof(void*)),
         n_bytes);
 
     out_memptr = (status == 0) ? memptr : nullptr;
+
+#if defined(CPP11ARMADILLO_USE_HUGEPAGES) && defined(MADV_HUGEPAGE)
+    if (huge_pages && (out_memptr != nullptr)) {
+      // only advice, the kernel falls back to normal pages if it has to
+      madvise((void*)out_memptr, n_bytes, MADV_HUGEPAGE);
+    }
+#endif
   }
 #elif defined(_MSC_VER)
   {
@@ -95,6 +124,9 @@ arma_malloc inline eT* memory::acquire(const uword n_elem) {
 
   arma_check_bad_alloc((out_memptr == nullptr), "arma::memory::acquire(): out of memory");
 
+  // Pacha: opt-in allocation counters (r_telemetry.hpp)
+  ARMA_TELEMETRY_ACQUIRE((const void*)(out_memptr), sizeof(eT) * size_t(n_elem));
+
   return out_memptr;
 }
 
@@ -104,6 +136,8 @@ arma_inline void memory::release(eT* mem) {
     return;
   }
 
+  ARMA_TELEMETRY_RELEASE((const void*)(mem));
+
 #if defined(ARMA_ALIEN_MEM_FREE_FUNCTION)
   {
     ARMA_ALIEN_MEM_FREE_FUNCTION((void*)(mem));
@@ -18,14 +18,24 @@
 //! \addtogroup mp_misc
 //! @{
 
+// Pacha: the threshold depends on the cost class of the operation (see r_parallel.hpp)
+// instead of being arma_config::mp_threshold for every operation. eval_nested() also
+// passes inside a parallel region when the operation can run as OpenMP tasks (see
+// mp_tasks below)
+
 template <typename eT, const bool use_smaller_thresh = false>
 struct mp_gate {
-  arma_inline static bool eval(const uword n_elem) {
+  arma_inline static bool eval(const uword n_elem,
+                               const int cost = ::Parallel::moderate) {
 #if defined(ARMA_USE_OPENMP)
     {
-      const bool length_ok = (is_cx<eT>::yes || use_smaller_thresh)
-                                 ? (n_elem >= (arma_config::mp_threshold / uword(2)))
-                                 : (n_elem >= arma_config::mp_threshold);
+      const size_t threshold = ::Parallel::threshold(cost);
+
+      const bool length_ok = (threshold == ::Parallel::never)
+                                 ? false
+                                 : ((is_cx<eT>::yes || use_smaller_thresh)
+                                        ? (size_t(n_elem) >= (threshold / size_t(2)))
+                                        : (size_t(n_elem) >= threshold));
 
       if (length_ok) {
         if (omp_in_parallel()) {
@@ -38,17 +48,40 @@ struct mp_gate {
 #else
     {
       arma_ignore(n_elem);
+      arma_ignore(cost);
 
       return false;
     }
 #endif
   }
+
+  arma_inline static bool eval_nested(const uword n_elem,
+                                      const int cost = ::Parallel::moderate) {
+#if defined(CPP11ARMADILLO_USE_TASKS)
+    {
+      if (omp_in_parallel()) {
+        const size_t threshold = ::Parallel::threshold(cost);
+
+        return ::Parallel::tasks() && (omp_get_num_threads() > 1) &&
+               (threshold != ::Parallel::never) &&
+               ((is_cx<eT>::yes || use_smaller_thresh)
+                    ? (size_t(n_elem) >= (threshold / size_t(2)))
+                    : (size_t(n_elem) >= threshold));
+      }
+    }
+#endif
+
+    return eval(n_elem, cost);
+  }
 };
 
 struct mp_thread_limit {
   arma_inline static int get() {
 #if defined(ARMA_USE_OPENMP)
-    int n_threads = (std::min)(int(arma_config::mp_threads),
+    // Pacha: the budget set with Parallel::set_threads() replaces ARMA_OPENMP_THREADS
+    const int budget = ::Parallel::threads();
+
+    int n_threads = (std::min)((budget > 0) ? budget : int(arma_config::mp_threads),
                                int((std::max)(int(1), int(omp_get_max_threads()))));
 #else
     int n_threads = int(1);
@@ -70,4 +103,104 @@ struct mp_thread_limit {
   }
 };
 
+// Pacha: nested parallelism. Inside a parallel region (e.g. a loop over bootstrap
+// replicates in user code), operations that passed mp_gate::eval_nested() are split
+// in several chunks per thread of the enclosing team and run as OpenMP tasks, which
+// the threads that are idle or waiting at a barrier pick up. Outside a parallel region
+// each thread gets one chunk, as with "omp parallel for schedule(static)".
+// Parallel::set_tasks(false) or -DCPP11ARMADILLO_NO_TASKS keeps them serial.
+
+struct mp_tasks {
+  // number of chunks for an operation started now
+
+  inline static uword chunks() {
+#if defined(ARMA_USE_OPENMP)
+    {
+      if (omp_in_parallel()) {
+#if defined(CPP11ARMADILLO_USE_TASKS)
+        if (::Parallel::tasks() && omp_get_num_threads() > 1) {
+          return uword(4) * uword(omp_get_num_threads());
+        }
+#endif
+
+        return uword(1);
+      }
+    }
+#endif
+
+    return uword(mp_thread_limit::get());
+  }
+};
+
+// runs body(t) for t = 0, ..., n_chunks - 1
+
+template <typename F>
+inline void mp_chunks(const uword n_chunks, const F& body) {
+#if defined(ARMA_USE_OPENMP)
+  if (omp_in_parallel() == false) {
+    const int n_threads = int((std::min)(n_chunks, uword(mp_thread_limit::get())));
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+    for (uword t = 0; t < n_chunks; ++t) {
+      body(t);
+    }
+
+    return;
+  }
+
+#if defined(CPP11ARMADILLO_USE_TASKS)
+  if (n_chunks > 1 && ::Parallel::tasks()) {
+#pragma omp taskloop grainsize(1) default(shared)
+    for (uword t = 0; t < n_chunks; ++t) {
+      body(t);
+    }
+
+    return;
+  }
+#endif
+#endif
+
+  for (uword t = 0; t < n_chunks; ++t) {
+    body(t);
+  }
+}
+
+// runs body(start, end) over [0, n_elem), split in mp_tasks::chunks() contiguous
+// ranges (multiples of 8 elements, so that SIMD kernels keep full vectors)
+
+template <typename F>
+inline void mp_ranges(const uword n_elem, const F& body) {
+  const uword n_chunks = (std::max)(uword(1), (std::min)(mp_tasks::chunks(), n_elem));
+  const uword chunk = (((n_elem + n_chunks - 1) / n_chunks) + uword(7)) & ~uword(7);
+
+  mp_chunks(n_chunks, [&](const uword t) {
+    const uword start = t * chunk;
+
+    if (start < n_elem) {
+      body(start, (std::min)(start + chunk, n_elem));
+    }
+  });
+}
+
+// Pacha: runs kernel(start, length) over an array, split across threads (or tasks)
+// when use_mp is set (SIMD kernels in eop_core, eglue_core, the relational operators
+// and normpdf()/log_normpdf()/normcdf(), see r_simd.hpp)
+
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+
+template <typename F>
+inline void simd_run(const uword n_elem, const bool use_mp, const F& kernel) {
+  if (use_mp) {
+    mp_ranges(n_elem, [&](const uword start, const uword end) {
+      kernel(start, end - start);
+    });
+
+    return;
+  }
+
+  kernel(uword(0), n_elem);
+}
+
+#endif
+
 //! @}
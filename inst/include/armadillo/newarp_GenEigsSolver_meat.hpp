@@ -373,6 +373,10 @@ inline uword GenEigsSolver<eT, SelectionRule, OpType>::compute(uword maxit, eT t
       break;
     }
 
+    if (ARMA_CHECK_INTERRUPT()) {
+      break;
+    }
+
     nev_adj = nev_adjusted(nconv);
     restart(nev_adj);
   }
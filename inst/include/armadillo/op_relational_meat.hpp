@@ -26,6 +26,86 @@
 #undef arma_applier_cube_pre
 #undef arma_applier_cube_post
 
+// Pacha: explicit SIMD kernels (r_simd.hpp) for contiguous double precision memory,
+// used by the relational operators of this file and of glue_relational_meat.hpp.
+// The functions return false when the kernels do not apply.
+
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+
+template <typename op_type>
+struct op_rel_simd {
+  static constexpr int op = -1;
+};
+
+// clang-format off
+template <> struct op_rel_simd<op_rel_lt_pre> { static constexpr int op = SimdKernels::gt; };
+template <> struct op_rel_simd<op_rel_gt_pre> { static constexpr int op = SimdKernels::lt; };
+template <> struct op_rel_simd<op_rel_lteq_pre> { static constexpr int op = SimdKernels::gteq; };
+template <> struct op_rel_simd<op_rel_gteq_pre> { static constexpr int op = SimdKernels::lteq; };
+template <> struct op_rel_simd<op_rel_lt_post> { static constexpr int op = SimdKernels::lt; };
+template <> struct op_rel_simd<op_rel_gt_post> { static constexpr int op = SimdKernels::gt; };
+template <> struct op_rel_simd<op_rel_lteq_post> { static constexpr int op = SimdKernels::lteq; };
+template <> struct op_rel_simd<op_rel_gteq_post> { static constexpr int op = SimdKernels::gteq; };
+template <> struct op_rel_simd<op_rel_eq> { static constexpr int op = SimdKernels::eq; };
+template <> struct op_rel_simd<op_rel_noteq> { static constexpr int op = SimdKernels::noteq; };
+template <> struct op_rel_simd<glue_rel_lt> { static constexpr int op = SimdKernels::lt; };
+template <> struct op_rel_simd<glue_rel_gt> { static constexpr int op = SimdKernels::gt; };
+template <> struct op_rel_simd<glue_rel_lteq> { static constexpr int op = SimdKernels::lteq; };
+template <> struct op_rel_simd<glue_rel_gteq> { static constexpr int op = SimdKernels::gteq; };
+template <> struct op_rel_simd<glue_rel_eq> { static constexpr int op = SimdKernels::eq; };
+template <> struct op_rel_simd<glue_rel_noteq> { static constexpr int op = SimdKernels::noteq; };
+// clang-format on
+
+// (a op b), or (a op k) when b is null
+template <typename op_type>
+inline bool op_rel_simd_run(uword* out, const double* a, const double* b, const double k,
+                            const uword n_elem) {
+  unsigned long long* o = simd_mask_out(out);
+
+  if (op_rel_simd<op_type>::op < 0 || o == nullptr || a == nullptr) {
+    return false;
+  }
+
+  Simd::kernels().relational[(op_rel_simd<op_type>::op < 0) ? 0 : op_rel_simd<op_type>::op](
+      o, a, b, k, n_elem);
+
+  return true;
+}
+
+template <template <typename, typename, typename> class mtOp_type, typename T1,
+          typename op_type, typename ea_type, typename eT>
+inline bool op_rel_simd_apply(uword* out, const ea_type& A, const eT& val,
+                              const uword n_elem, const mtOp_type<uword, T1, op_type>&) {
+  return op_rel_simd_run<op_type>(out, simd_mem(A), nullptr, simd_scalar(val), n_elem);
+}
+
+template <template <typename, typename, typename, typename> class mtGlue_type,
+          typename T1, typename T2, typename glue_type, typename ea_type1,
+          typename ea_type2>
+inline bool glue_rel_simd_apply(uword* out, const ea_type1& A, const ea_type2& B,
+                                const uword n_elem,
+                                const mtGlue_type<uword, T1, T2, glue_type>&) {
+  const double* b = simd_mem(B);
+
+  return (b != nullptr) && op_rel_simd_run<glue_type>(out, simd_mem(A), b, 0.0, n_elem);
+}
+
+#else
+
+template <typename ea_type, typename eT, typename expr_type>
+inline bool op_rel_simd_apply(uword*, const ea_type&, const eT&, const uword,
+                              const expr_type&) {
+  return false;
+}
+
+template <typename ea_type1, typename ea_type2, typename expr_type>
+inline bool glue_rel_simd_apply(uword*, const ea_type1&, const ea_type2&, const uword,
+                                const expr_type&) {
+  return false;
+}
+
+#endif
+
 #define arma_applier_mat_pre(operator_rel)                                            \
   {                                                                                   \
     typedef typename T1::elem_type eT;                                                \
@@ -49,8 +129,10 @@
         ea_type PA = P.get_ea();                                                      \
         const uword n_elem = out.n_elem;                                              \
                                                                                       \
-        for (uword i = 0; i < n_elem; ++i) {                                          \
-          out_mem[i] = (val operator_rel PA[i]) ? uword(1) : uword(0);                \
+        if (op_rel_simd_apply(out_mem, PA, val, n_elem, X) == false) {                \
+          for (uword i = 0; i < n_elem; ++i) {                                        \
+            out_mem[i] = (val operator_rel PA[i]) ? uword(1) : uword(0);              \
+          }                                                                           \
         }                                                                             \
       } else {                                                                        \
         if (n_rows == 1) {                                                            \
@@ -95,8 +177,10 @@
         ea_type PA = P.get_ea();                                                      \
         const uword n_elem = out.n_elem;                                              \
                                                                                       \
-        for (uword i = 0; i < n_elem; ++i) {                                          \
-          out_mem[i] = (PA[i] operator_rel val) ? uword(1) : uword(0);                \
+        if (op_rel_simd_apply(out_mem, PA, val, n_elem, X) == false) {                \
+          for (uword i = 0; i < n_elem; ++i) {                                        \
+            out_mem[i] = (PA[i] operator_rel val) ? uword(1) : uword(0);              \
+          }                                                                           \
         }                                                                             \
       } else {                                                                        \
         if (n_rows == 1) {                                                            \
@@ -142,8 +226,10 @@
         ea_type PA = P.get_ea();                                                         \
         const uword n_elem = out.n_elem;                                                 \
                                                                                          \
-        for (uword i = 0; i < n_elem; ++i) {                                             \
-          out_mem[i] = (val operator_rel PA[i]) ? uword(1) : uword(0);                   \
+        if (op_rel_simd_apply(out_mem, PA, val, n_elem, X) == false) {                   \
+          for (uword i = 0; i < n_elem; ++i) {                                           \
+            out_mem[i] = (val operator_rel PA[i]) ? uword(1) : uword(0);                 \
+          }                                                                              \
         }                                                                                \
       } else {                                                                           \
         for (uword slice = 0; slice < n_slices; ++slice)                                 \
@@ -184,8 +270,10 @@
         ea_type PA = P.get_ea();                                                         \
         const uword n_elem = out.n_elem;                                                 \
                                                                                          \
-        for (uword i = 0; i < n_elem; ++i) {                                             \
-          out_mem[i] = (PA[i] operator_rel val) ? uword(1) : uword(0);                   \
+        if (op_rel_simd_apply(out_mem, PA, val, n_elem, X) == false) {                   \
+          for (uword i = 0; i < n_elem; ++i) {                                           \
+            out_mem[i] = (PA[i] operator_rel val) ? uword(1) : uword(0);                 \
+          }                                                                              \
         }                                                                                \
       } else {                                                                           \
         for (uword slice = 0; slice < n_slices; ++slice)                                 \
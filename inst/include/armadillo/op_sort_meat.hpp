@@ -129,6 +129,7 @@ inline void op_sort::apply_noalias(Mat<eT>& out, const Mat<eT>& X, const uword s
 template <typename T1>
 inline void op_sort::apply(Mat<typename T1::elem_type>& out, const Op<T1, op_sort>& in) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("op_sort::apply");
 
   typedef typename T1::elem_type eT;
 
@@ -157,6 +158,7 @@ template <typename T1>
 inline void op_sort_vec::apply(Mat<typename T1::elem_type>& out,
                                const Op<T1, op_sort_vec>& in) {
   arma_debug_sigprint();
+  ARMA_TELEMETRY_SCOPE("op_sort_vec::apply");
 
   typedef typename T1::elem_type eT;
 
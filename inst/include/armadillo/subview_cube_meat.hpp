@@ -123,8 +123,8 @@ inline void subview_cube<eT>::inplace_op(const BaseCube<eT, T1>& in,
 
   arma_conform_assert_same_size(t, P, identifier);
 
-  const bool use_mp =
-      arma_config::openmp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(t.n_elem);
+  const bool use_mp = arma_config::openmp && ProxyCube<T1>::use_mp &&
+                      mp_gate<eT>::eval(t.n_elem, mp_cost<T1>::value);
   const bool has_overlap = P.has_overlap(t);
 
   if (has_overlap) {
@@ -156,8 +156,8 @@ inline void subview<eT>::inplace_op(const Base<eT, T1>& in, const char* identifi
 
   arma_conform_assert_same_size(s, P, identifier);
 
-  const bool use_mp =
-      arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(s.n_elem);
+  const bool use_mp = arma_config::openmp && Proxy<T1>::use_mp &&
+                      mp_gate<eT>::eval(s.n_elem, mp_cost<T1>::value);
   const bool has_overlap = P.has_overlap(s);
 
   if (has_overlap) {
@@ -9,7 +9,11 @@
 #include <Rmath.h>
 #include <armadillo.hpp>
 #include <cpp11.hpp>
+#include <wrappers/dimensions.hpp>
+#include <wrappers/altrep.hpp>
+#include <wrappers/cubes.hpp>
 #include <wrappers/matrices.hpp>
+#include <wrappers/random.hpp>
 #include <wrappers/sparse_matrices.hpp>
 #include <wrappers/vectors.hpp>
 
@@ -25,7 +29,11 @@ class arma_rng_alt {
     (void)val;  // No-op, cannot set seed in R from C++ code
   }
 
-  arma_inline static int randi_val() { return static_cast<int>(::Rf_runif(0, RAND_MAX)); }
+  // R_unif_index() rejects out of range values instead of scaling, which is biased
+
+  arma_inline static int randi_val() {
+    return static_cast<int>(::R_unif_index(static_cast<double>(RAND_MAX) + 1.0));
+  }
 
   arma_inline static double randu_val() { return ::Rf_runif(0, 1); }
 
@@ -41,11 +49,7 @@ class arma_rng_alt {
 
   template <typename eT>
   inline static void randi_fill(eT* mem, const arma::uword N, const int a, const int b) {
-    const arma::uword length = b - a + 1;
-    const double scale = static_cast<double>(length) / RAND_MAX;
-    for (arma::uword i = 0; i < N; ++i) {
-      mem[i] = std::min(b, static_cast<int>(::Rf_runif(0, RAND_MAX) * scale) + a);
-    }
+    RRngBlock::fill_randi(mem, N, a, b);
   }
 
   inline static int randi_max_val() { return RAND_MAX; }
@@ -79,22 +83,48 @@ class arma_rng {
     }
   };
 
+  // Random permutations, also one draw from R's RNG per call
+
+  template <typename eT>
+  inline static void shuffle(eT* mem, const arma::uword N) {
+    RRngBlock::shuffle(mem, N);
+  }
+
+  inline static arma::uvec randperm(const arma::uword N) {
+    arma::uvec x(N, arma::fill::none);
+    arma::uword* mem = x.memptr();
+
+#pragma omp parallel for simd schedule(static) if (N > 10000) \
+    num_threads(Parallel::max_threads())
+    for (arma::uword i = 0; i < N; ++i) {
+      mem[i] = i;
+    }
+
+    RRngBlock::shuffle(mem, N);
+    return x;
+  }
+
+  inline static arma::uvec randperm(const arma::uword N, const arma::uword M) {
+    if (M > N) {
+      cpp11::stop("randperm(): 'M' must be less than or equal to 'N'");
+    }
+    arma::uvec x = randperm(N);
+    return x.head(M);
+  }
+
   template <typename eT>
   struct randu {
     inline operator eT() { return eT(arma_rng_alt::randu_val()); }
 
+    // One draw from R's RNG per fill, see wrappers/random.hpp
+
     inline static void fill(eT* mem, const arma::uword N) {
-      for (arma::uword i = 0; i < N; ++i) {
-        mem[i] = eT(arma_rng_alt::randu_val());
-      }
+      RRngBlock::fill_randu(mem, N, 0.0, 1.0);
     }
 
     inline static void fill(eT* mem, const arma::uword N, const double a,
                             const double b) {
-      const double r = b - a;
-      for (arma::uword i = 0; i < N; ++i) {
-        mem[i] = eT(arma_rng_alt::randu_val() * r + a);
-      }
+      RRngBlock::fill_randu(mem, N, a, b - a);
     }
   };
 
@@ -103,17 +133,26 @@ class arma_rng {
     inline operator eT() const { return eT(arma_rng_alt::randn_val()); }
 
     inline static void fill(eT* mem, const arma::uword N) {
-      for (arma::uword i = 0; i < N; ++i) {
-        mem[i] = eT(arma_rng_alt::randn_val());
-      }
+      RRngBlock::fill_randn(mem, N, 0.0, 1.0);
     }
 
     inline static void fill(eT* mem, const arma::uword N, const double mu,
                             const double sd) {
-      for (arma::uword i = 0; i < N; ++i) {
-        const eT val = eT(arma_rng_alt::randn_val());
-        mem[i] = (val * sd) + mu;
+      RRngBlock::fill_randn(mem, N, mu, sd);
+    }
+  };
+
+  // Gamma with shape a and scale b, chi2(df) is gamma(df / 2, 2)
+
+  template <typename eT>
+  struct randg {
+    inline static void fill(eT* mem, const arma::uword N, const double a,
+                            const double b) {
+      if (!(a > 0) || !(b > 0)) {
+        cpp11::stop("randg(): a and b must be greater than zero");
       }
+
+      RRngBlock::fill_randg(mem, N, a, b);
     }
   };
 };
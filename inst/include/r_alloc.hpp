@@ -0,0 +1,143 @@
+// Opt-in allocator that places Armadillo memory inside R vectors, so that results can
+// be handed back to R without a final copy.
+//
+// Enable it for the whole package with -DCPP11ARMADILLO_USE_R_ALLOC in PKG_CPPFLAGS.
+// The flag must be the same in every translation unit, otherwise memory acquired by
+// one allocator could be released by the other one.
+
+#pragma once
+
+#include <cpp11.hpp>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(CPP11ARMADILLO_USE_R_ALLOC)
+
+// smaller blocks (in bytes) are not worth a trip to R's allocator
+#if !defined(CPP11ARMADILLO_R_ALLOC_THRESHOLD)
+#define CPP11ARMADILLO_R_ALLOC_THRESHOLD 1024
+#endif
+
+class RAllocator {
+ public:
+  // Large blocks requested from the main thread live inside a REALSXP, everything
+  // else (small blocks, worker threads) falls back to malloc()
+
+  static void* acquire(const size_t n_bytes) {
+    if (n_bytes < CPP11ARMADILLO_R_ALLOC_THRESHOLD || !on_main_thread()) {
+      return std::malloc(n_bytes);
+    }
+
+    release_pending();
+
+    const R_xlen_t n = static_cast<R_xlen_t>((n_bytes + sizeof(double) - 1) /
+                                             sizeof(double));
+
+    cpp11::sexp x = cpp11::safe[Rf_allocVector](REALSXP, n);
+    void* mem = REAL(x);
+
+    registry& reg = instance();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.owners.emplace(mem, x);
+
+    return mem;
+  }
+
+  // R objects can only be unprotected from the main thread, blocks released from a
+  // worker thread are queued and unprotected on the next acquire() from the main one
+
+  static void release(void* mem) {
+    registry& reg = instance();
+
+    {
+      std::lock_guard<std::mutex> lock(reg.mutex);
+
+      auto it = reg.owners.find(mem);
+
+      if (it != reg.owners.end()) {
+        if (on_main_thread()) {
+          reg.owners.erase(it);
+        } else {
+          reg.pending.push_back(mem);
+        }
+        return;
+      }
+    }
+
+    std::free(mem);
+  }
+
+  // R vector that owns `mem`, or R_NilValue when the memory was not allocated by R or
+  // the vector does not hold exactly n_elem doubles (e.g. a Mat that shrank in place)
+
+  static SEXP owner(const void* mem, const R_xlen_t n_elem) {
+    registry& reg = instance();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    auto it = reg.owners.find(mem);
+
+    if (it == reg.owners.end() || Rf_xlength(it->second) != n_elem) {
+      return R_NilValue;
+    }
+
+    return it->second;
+  }
+
+  // Takes the R vector that holds a Mat, Col or Cube and leaves the object empty, so
+  // that nothing can write to the memory once it belongs to R. R_NilValue when the
+  // memory was not allocated by R.
+
+  template <typename T>
+  static cpp11::sexp take(T& x) {
+    cpp11::sexp y = (x.mem_state == 0) ? owner(x.memptr(), x.n_elem) : R_NilValue;
+
+    if (y != R_NilValue) {
+      x.reset();
+    }
+
+    return y;
+  }
+
+  static const std::thread::id& main_thread() {
+    static const std::thread::id id = std::this_thread::get_id();
+    return id;
+  }
+
+ private:
+  struct registry {
+    std::mutex mutex;
+    std::unordered_map<const void*, cpp11::sexp> owners;
+    std::vector<const void*> pending;
+  };
+
+  static registry& instance() {
+    static registry reg;
+    return reg;
+  }
+
+  static bool on_main_thread() { return std::this_thread::get_id() == main_thread(); }
+
+  static void release_pending() {
+    registry& reg = instance();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    for (const void* mem : reg.pending) {
+      reg.owners.erase(mem);
+    }
+
+    reg.pending.clear();
+  }
+};
+
+// R loads shared libraries from the main thread, so this pins its id at load time
+static const bool r_allocator_main_thread_ready = (RAllocator::main_thread(), true);
+
+#if !defined(ARMA_ALIEN_MEM_ALLOC_FUNCTION)
+#define ARMA_ALIEN_MEM_ALLOC_FUNCTION ::RAllocator::acquire
+#define ARMA_ALIEN_MEM_FREE_FUNCTION ::RAllocator::release
+#endif
+
+#endif
@@ -0,0 +1,214 @@
+// Cooperative cancellation for long-running Armadillo kernels (k-means, GMM
+// training, iterative eigensolvers).
+//
+// The loops poll a shared flag. On R's main thread the poll also checks for a user
+// interrupt (Ctrl+C / Esc) and an optional deadline, so OpenMP workers stop early
+// and the main thread raises an R error between iterations.
+//
+// An exception cannot leave a parallel region, so a kernel that runs inside one of
+// the calling code (or on another thread) gives up without raising the error and the
+// flag stays set. The code around the region then calls RInterrupt::check() to raise
+// it.
+//
+// Time limits are set for a scope with RInterruptDeadline, which also clears a
+// cancellation that was not reported when the scope ends, so later calls start clean.
+//
+// Disable it with -DCPP11ARMADILLO_NO_INTERRUPT in PKG_CPPFLAGS.
+
+#pragma once
+
+#include <cpp11.hpp>
+#include <R_ext/Utils.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#if !defined(CPP11ARMADILLO_NO_INTERRUPT)
+
+// minimum time (in milliseconds) between two calls to R_CheckUserInterrupt()
+#if !defined(CPP11ARMADILLO_INTERRUPT_INTERVAL)
+#define CPP11ARMADILLO_INTERRUPT_INTERVAL 100
+#endif
+
+class RInterrupt {
+ public:
+  typedef std::chrono::steady_clock clock;
+
+  static bool requested() { return state().flag.load(std::memory_order_relaxed); }
+
+  static void request() { state().flag.store(true, std::memory_order_relaxed); }
+
+  // clears the flag and the deadline, done after the interruption was reported
+
+  static void reset() {
+    state().flag.store(false, std::memory_order_relaxed);
+    state().deadline.store(0, std::memory_order_relaxed);
+  }
+
+  // stop the computations that are still running after `seconds`, zero or a negative
+  // value removes the deadline. The deadline stays until it is removed or reset() is
+  // called, prefer RInterruptDeadline, which removes it at the end of a scope.
+
+  static void set_deadline(const double seconds) {
+    long long t = 0;
+
+    if (seconds > 0) {
+      const std::chrono::duration<double> d(seconds);
+      t = ticks(clock::now() + std::chrono::duration_cast<clock::duration>(d));
+    }
+
+    state().deadline.store(t, std::memory_order_relaxed);
+  }
+
+  // Safe to call from any thread. Worker threads only read the flag, the main thread
+  // also looks at the deadline and at R's interrupt status (throttled, this is called
+  // from inner loops).
+
+  static bool poll() {
+    registry& st = state();
+
+    if (st.flag.load(std::memory_order_relaxed)) {
+      return true;
+    }
+
+    if (std::this_thread::get_id() != main_thread()) {
+      return false;
+    }
+
+    if ((++st.counter & 1023) != 0) {
+      return false;
+    }
+
+    const long long now = ticks(clock::now());
+    const long long deadline = st.deadline.load(std::memory_order_relaxed);
+
+    if (deadline > 0 && now >= deadline) {
+      request();
+      return true;
+    }
+
+    if (now - st.last_check < interval()) {
+      return false;
+    }
+
+    st.last_check = now;
+
+    // R_CheckUserInterrupt() jumps out of the current context, R_ToplevelExec()
+    // catches the jump and returns FALSE instead
+    if (R_ToplevelExec(check_user_interrupt, nullptr) == FALSE) {
+      request();
+      return true;
+    }
+
+    return false;
+  }
+
+  // Called between iterations, returns true when the computation was cancelled. On
+  // R's main thread outside of parallel regions it raises an R error instead.
+
+  static bool check() {
+    const bool main = (std::this_thread::get_id() == main_thread());
+
+    if (main) {
+      state().counter = 1023;
+    }
+
+    if (poll() == false) {
+      return false;
+    }
+
+    if (main && (parallel_level() == 0)) {
+      reset();
+      cpp11::stop("Computation interrupted");
+    }
+
+    return true;
+  }
+
+  static const std::thread::id& main_thread() {
+    static const std::thread::id id = std::this_thread::get_id();
+    return id;
+  }
+
+ private:
+  friend class RInterruptDeadline;
+
+  struct registry {
+    std::atomic<bool> flag{false};
+    std::atomic<long long> deadline{0};
+    unsigned int counter = 0;  // main thread only
+    long long last_check = 0;  // main thread only
+  };
+
+  static registry& state() {
+    static registry st;
+    return st;
+  }
+
+  static long long ticks(const clock::time_point t) {
+    return static_cast<long long>(t.time_since_epoch().count());
+  }
+
+  static long long interval() {
+    return static_cast<long long>(
+        std::chrono::duration_cast<clock::duration>(
+            std::chrono::milliseconds(CPP11ARMADILLO_INTERRUPT_INTERVAL))
+            .count());
+  }
+
+  static void check_user_interrupt(void*) { R_CheckUserInterrupt(); }
+
+  // nesting level of parallel regions, inactive ones (a team of one thread) included
+
+  static int parallel_level() {
+#if defined(_OPENMP)
+    return omp_get_level();
+#else
+    return 0;
+#endif
+  }
+};
+
+// Deadline for the computations in a scope, e.g.
+//
+// {
+//   RInterruptDeadline deadline(2.0);
+//   status = kmeans(means, data, k, random_subset, 100, false);
+// }
+//
+// At the end of the scope the previous deadline comes back and the flag is cleared,
+// so neither an unused deadline nor a cancellation that nobody reported (a kernel that
+// stopped inside a parallel region) affects later computations.
+
+class RInterruptDeadline {
+ public:
+  explicit RInterruptDeadline(const double seconds)
+      : previous_(RInterrupt::state().deadline.load(std::memory_order_relaxed)) {
+    RInterrupt::set_deadline(seconds);
+  }
+
+  ~RInterruptDeadline() {
+    RInterrupt::state().flag.store(false, std::memory_order_relaxed);
+    RInterrupt::state().deadline.store(previous_, std::memory_order_relaxed);
+  }
+
+  RInterruptDeadline(const RInterruptDeadline&) = delete;
+  RInterruptDeadline& operator=(const RInterruptDeadline&) = delete;
+
+ private:
+  const long long previous_;
+};
+
+// R loads shared libraries from the main thread, so this pins its id at load time
+static const bool r_interrupt_main_thread_ready = (RInterrupt::main_thread(), true);
+
+#if !defined(ARMA_CHECK_INTERRUPT)
+#define ARMA_CHECK_INTERRUPT() ::RInterrupt::check()
+#define ARMA_INTERRUPT_REQUESTED() ::RInterrupt::poll()
+#endif
+
+#endif
@@ -0,0 +1,461 @@
+// Size thresholds for running element-wise operations with OpenMP, one per cost
+// class instead of the single ARMA_OPENMP_THRESHOLD. Cheap operations (+, -, %, abs()
+// and the like) need far larger objects than exp() or pow() before a team of threads
+// pays for itself.
+//
+// The defaults keep the behaviour of Armadillo: moderate and expensive operations use
+// ARMA_OPENMP_THRESHOLD, cheap ones stay serial. Parallel::calibrate() measures the
+// start-up time of a team of threads and the cost per element of each class on the
+// host, and stores the sizes where threads start to win. Parallel::set_thresholds()
+// overrides them from R.
+//
+// Parallel::set_threads() sets a thread budget at run time, which replaces
+// ARMA_OPENMP_THREADS (fixed when the package is installed) for all the OpenMP loops
+// of Armadillo and cpp11armadillo, and is passed on to OpenBLAS, FlexiBLAS or MKL when
+// R uses one of them. ParallelThreads sets it for a scope, as withr::local_*() does.
+//
+// Inside a parallel region of the calling code, large operations run as OpenMP tasks
+// for the idle threads of that region instead of serially (see mp_tasks in
+// armadillo/mp_misc.hpp). This needs OpenMP 4.5, and -DCPP11ARMADILLO_NO_TASKS or
+// Parallel::set_tasks(false) turns it off.
+
+#pragma once
+
+#include <cpp11.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#endif
+
+#if !defined(ARMA_DONT_USE_OPENMP) && defined(_OPENMP) && (_OPENMP >= 201107)
+#include <omp.h>
+#define CPP11ARMADILLO_PARALLEL_OPENMP
+#endif
+
+#if defined(CPP11ARMADILLO_PARALLEL_OPENMP) && (_OPENMP >= 201511) && \
+    !defined(CPP11ARMADILLO_NO_TASKS)
+#define CPP11ARMADILLO_USE_TASKS
+#endif
+
+class Parallel {
+ public:
+  // cheap: arithmetic, comparisons, abs(), floor() and other operations without
+  // openmp in Armadillo. moderate: sqrt(), exp(), log(), trigonometric and error
+  // functions. expensive: pow(), tan(), the inverse and hyperbolic trigonometric
+  // functions other than tanh(), lgamma() and tgamma().
+
+  enum cost_type { cheap = 0, moderate = 1, expensive = 2, n_costs = 3 };
+
+  // threshold of a class that never uses threads
+
+  static constexpr size_t never = (std::numeric_limits<size_t>::max)();
+
+  static size_t threshold(const int cost) {
+    return state().thresholds[clamp(cost)].load(std::memory_order_relaxed);
+  }
+
+  static void set_threshold(const int cost, const size_t n_elem) {
+    state().thresholds[clamp(cost)].store((n_elem < 1) ? 1 : n_elem,
+                                          std::memory_order_relaxed);
+  }
+
+  static void reset_thresholds() {
+    for (int c = 0; c < n_costs; ++c) {
+      set_threshold(c, default_threshold(c));
+    }
+
+    state().calibrated.store(false, std::memory_order_relaxed);
+  }
+
+  static const char* name(const int cost) {
+    switch (cost) {
+      case cheap:
+        return "cheap";
+      case moderate:
+        return "moderate";
+      default:
+        return "expensive";
+    }
+  }
+
+  // The thresholds as a named R vector, Inf for a class that never uses threads
+
+  static cpp11::writable::doubles thresholds() {
+    cpp11::writable::doubles out(static_cast<R_xlen_t>(n_costs));
+    cpp11::writable::strings names(static_cast<R_xlen_t>(n_costs));
+
+    for (int c = 0; c < n_costs; ++c) {
+      const size_t n = threshold(c);
+      out[c] = (n == never) ? R_PosInf : static_cast<double>(n);
+      names[c] = name(c);
+    }
+
+    out.attr("names") = names;
+
+    return out;
+  }
+
+  // Overrides the thresholds given by name, e.g. c(cheap = 1e5, expensive = 64).
+  // Inf disables threads for the class and NA keeps its current value. Every element
+  // must be named after a cost class, and nothing changes unless all of them are valid.
+
+  static cpp11::writable::doubles set_thresholds(const cpp11::doubles& x) {
+    const R_xlen_t n_x = x.size();
+    SEXP names = Rf_getAttrib(x, R_NamesSymbol);
+
+    if (n_x > 0 && names == R_NilValue) {
+      cpp11::stop("the thresholds must be named 'cheap', 'moderate' or 'expensive'");
+    }
+
+    std::vector<int> costs(static_cast<size_t>(n_x));
+
+    for (R_xlen_t i = 0; i < n_x; ++i) {
+      SEXP key = STRING_ELT(names, i);
+
+      if (key == NA_STRING || CHAR(key)[0] == '\0') {
+        cpp11::stop("threshold %d has no name, use 'cheap', 'moderate' or 'expensive'",
+                    static_cast<int>(i + 1));
+      }
+
+      int cost = n_costs;
+
+      for (int c = 0; c < n_costs; ++c) {
+        cost = (std::strcmp(CHAR(key), name(c)) == 0) ? c : cost;
+      }
+
+      if (cost == n_costs) {
+        cpp11::stop("unknown cost class '%s', use 'cheap', 'moderate' or 'expensive'",
+                    CHAR(key));
+      }
+
+      const double n = x[i];
+
+      if (!ISNAN(n) && n < 1) {
+        cpp11::stop("the threshold for '%s' must be at least 1", CHAR(key));
+      }
+
+      costs[static_cast<size_t>(i)] = cost;
+    }
+
+    for (R_xlen_t i = 0; i < n_x; ++i) {
+      const double n = x[i];
+
+      if (ISNAN(n)) {
+        continue;
+      }
+
+      set_threshold(costs[static_cast<size_t>(i)],
+                    (n >= static_cast<double>(never)) ? never : static_cast<size_t>(n));
+    }
+
+    return thresholds();
+  }
+
+  // Measures the thresholds on the host, once per session unless force is set.
+  // Without OpenMP, or with a single thread, they are left as they are.
+
+  static void calibrate(const bool force = false) {
+#if defined(CPP11ARMADILLO_PARALLEL_OPENMP)
+    if ((force || !state().calibrated.load(std::memory_order_relaxed)) &&
+        !omp_in_parallel() && max_threads() > 1) {
+      measure();
+      state().calibrated.store(true, std::memory_order_relaxed);
+    }
+#else
+    (void)force;
+#endif
+  }
+
+  static bool calibrated() { return state().calibrated.load(std::memory_order_relaxed); }
+
+  // Thread budget, 0 when it is not set (ARMA_OPENMP_THREADS applies)
+
+  static int threads() { return state().budget.load(std::memory_order_relaxed); }
+
+  // Sets the budget, or clears it when n < 1, and returns the previous one, so that
+  // set_threads(previous) restores it. The number of BLAS threads follows the budget
+  // and goes back to its initial value when the budget is cleared. Thresholds from
+  // calibrate() are measured with the budget in place at that time.
+
+  static int set_threads(const int n) {
+    registry& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+
+    const int budget = (n > 0) ? n : 0;
+    const int previous = st.budget.exchange(budget, std::memory_order_relaxed);
+
+    const blas_api& api = blas();
+
+    if (api.set != nullptr) {
+      if (budget > 0) {
+        st.blas_initial = (st.blas_initial > 0) ? st.blas_initial : api.get();
+        api.set(budget);
+      } else if (st.blas_initial > 0) {
+        api.set(st.blas_initial);
+        st.blas_initial = 0;
+      }
+    }
+
+    return previous;
+  }
+
+  // Number of threads for an OpenMP loop started now: the budget (or
+  // ARMA_OPENMP_THREADS), at most omp_get_max_threads(), and 1 without OpenMP
+
+  static int max_threads() {
+#if defined(CPP11ARMADILLO_PARALLEL_OPENMP)
+    const int budget = threads();
+#if defined(ARMA_OPENMP_THREADS)
+    const int limit = (budget > 0) ? budget : int(ARMA_OPENMP_THREADS);
+#else
+    const int limit = (budget > 0) ? budget : 8;
+#endif
+    return (std::min)(limit, (std::max)(1, int(omp_get_max_threads())));
+#else
+    return 1;
+#endif
+  }
+
+  // Whether operations inside a parallel region run as tasks. set_tasks() returns the
+  // previous setting.
+
+  static bool tasks() {
+#if defined(CPP11ARMADILLO_USE_TASKS)
+    return state().tasks.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+  }
+
+  static bool set_tasks(const bool enable) {
+    return state().tasks.exchange(enable, std::memory_order_relaxed);
+  }
+
+  // Threads of the BLAS library, 0 if it is not OpenBLAS, FlexiBLAS or MKL
+
+  static int blas_threads() {
+    const blas_api& api = blas();
+    return (api.get != nullptr) ? api.get() : 0;
+  }
+
+ private:
+  typedef std::chrono::steady_clock clock;
+
+  struct blas_api {
+    void (*set)(int) = nullptr;
+    int (*get)() = nullptr;
+  };
+
+  struct registry {
+    std::atomic<size_t> thresholds[n_costs];
+    std::atomic<bool> calibrated{false};
+    std::atomic<int> budget{0};
+    std::atomic<bool> tasks{true};
+    std::mutex mutex;
+    int blas_initial = 0;
+
+    registry() {
+      for (int c = 0; c < n_costs; ++c) {
+        thresholds[c].store(default_threshold(c), std::memory_order_relaxed);
+      }
+    }
+  };
+
+  static registry& state() {
+    static registry st;
+    return st;
+  }
+
+  // the setters of the BLAS library linked to R, looked up once
+
+  static const blas_api& blas() {
+    static const blas_api api = find_blas();
+    return api;
+  }
+
+  static blas_api find_blas() {
+    blas_api api;
+
+#if !defined(_WIN32)
+    static const char* const names[][2] = {
+        {"flexiblas_set_num_threads", "flexiblas_get_num_threads"},
+        {"openblas_set_num_threads", "openblas_get_num_threads"},
+        {"MKL_Set_Num_Threads", "MKL_Get_Max_Threads"}};
+
+    for (const auto& name : names) {
+      void* set = dlsym(RTLD_DEFAULT, name[0]);
+      void* get = dlsym(RTLD_DEFAULT, name[1]);
+
+      if (set != nullptr && get != nullptr) {
+        api.set = reinterpret_cast<void (*)(int)>(set);
+        api.get = reinterpret_cast<int (*)()>(get);
+        break;
+      }
+    }
+#endif
+
+    return api;
+  }
+
+  static int clamp(const int cost) {
+    return (cost < cheap) ? cheap : ((cost > expensive) ? expensive : cost);
+  }
+
+  static size_t default_threshold(const int cost) {
+#if defined(ARMA_OPENMP_THRESHOLD)
+    return (cost == cheap) ? never : size_t(ARMA_OPENMP_THRESHOLD);
+#else
+    return (cost == cheap) ? never : size_t(320);
+#endif
+  }
+
+#if defined(CPP11ARMADILLO_PARALLEL_OPENMP)
+
+  static double seconds(const clock::time_point start) {
+    return std::chrono::duration<double>(clock::now() - start).count();
+  }
+
+  // representative loop of each class, serial or split across n_threads
+
+  static void run(const int cost, double* out, const double* a, const size_t n,
+                  const int n_threads) {
+    const long long N = static_cast<long long>(n);
+
+    if (cost == cheap) {
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+      for (long long i = 0; i < N; ++i) {
+        out[i] = a[i] + out[i];
+      }
+    } else if (cost == moderate) {
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+      if (Simd::fast_math()) {
+        const SimdKernels::unary_fn f = Simd::kernels().unary[SimdKernels::exp];
+        const long long chunk = (N + n_threads - 1) / n_threads;
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+        for (long long t = 0; t < n_threads; ++t) {
+          const long long start = t * chunk;
+          const long long len = (std::min)(chunk, N - start);
+
+          if (len > 0) {
+            f(out + start, a + start, 0.0, static_cast<size_t>(len));
+          }
+        }
+
+        return;
+      }
+#endif
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+      for (long long i = 0; i < N; ++i) {
+        out[i] = std::exp(a[i]);
+      }
+    } else {
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+      for (long long i = 0; i < N; ++i) {
+        out[i] = std::pow(a[i], 1.37);
+      }
+    }
+  }
+
+  // best of a few runs, in seconds
+
+  static double best_time(const int cost, double* out, const double* a, const size_t n,
+                          const int n_threads) {
+    double best = std::numeric_limits<double>::infinity();
+
+    for (int r = 0; r < 5; ++r) {
+      const clock::time_point start = clock::now();
+      run(cost, out, a, n, n_threads);
+      best = (std::min)(best, seconds(start));
+    }
+
+    return best;
+  }
+
+  static void measure() {
+    const int n_threads = max_threads();
+
+    // inputs in (0.5, 1.5), so that no loop hits a special case
+    const size_t max_n = size_t(1) << 21;
+    std::vector<double> a(max_n), out(max_n);
+
+    for (size_t i = 0; i < max_n; ++i) {
+      a[i] = 0.5 + static_cast<double>((i * 2654435761u) % 1000003u) / 1000003.0;
+      out[i] = 1.0;
+    }
+
+    // start-up of a team with one element per thread (the median of repeated runs,
+    // after waking up the thread pool)
+    for (int r = 0; r < 5; ++r) {
+      run(cheap, out.data(), a.data(), size_t(n_threads), n_threads);
+    }
+
+    std::vector<double> overheads(51);
+
+    for (size_t r = 0; r < overheads.size(); ++r) {
+      const clock::time_point start = clock::now();
+      run(cheap, out.data(), a.data(), size_t(n_threads), n_threads);
+      overheads[r] = seconds(start);
+    }
+
+    std::nth_element(overheads.begin(), overheads.begin() + overheads.size() / 2,
+                     overheads.end());
+    const double overhead = overheads[overheads.size() / 2];
+
+    for (int c = 0; c < n_costs; ++c) {
+      // enough elements for about a millisecond of serial work
+      size_t n = 4096;
+      double serial = best_time(c, out.data(), a.data(), n, 1);
+
+      while (serial < 1e-3 && n < max_n) {
+        n *= 2;
+        serial = best_time(c, out.data(), a.data(), n, 1);
+      }
+
+      const double parallel = best_time(c, out.data(), a.data(), n, n_threads);
+
+      // cost per element, without the start-up of the team for the threaded run
+      const double c_serial = serial / static_cast<double>(n);
+      const double c_parallel =
+          (std::max)(parallel - overhead, 0.0) / static_cast<double>(n);
+
+      // threads win when n * c_serial > overhead + n * c_parallel
+      if (c_serial <= c_parallel || parallel >= serial) {
+        set_threshold(c, never);
+      } else {
+        const double n_min = std::ceil(overhead / (c_serial - c_parallel));
+        set_threshold(c, (n_min >= static_cast<double>(max_n) * 64)
+                             ? never
+                             : static_cast<size_t>((std::max)(n_min, 1.0)));
+      }
+    }
+  }
+
+#endif
+};
+
+// Sets the thread budget for the enclosing scope and restores the previous one when
+// it ends
+
+class ParallelThreads {
+ public:
+  explicit ParallelThreads(const int n) : previous_(Parallel::set_threads(n)) {}
+
+  ~ParallelThreads() { Parallel::set_threads(previous_); }
+
+  ParallelThreads(const ParallelThreads&) = delete;
+  ParallelThreads& operator=(const ParallelThreads&) = delete;
+
+ private:
+  int previous_;
+};
@@ -0,0 +1,323 @@
+// Opt-in pooled allocator for Armadillo memory. Blocks are grouped in power of two
+// size classes and kept in a per-thread cache when they are released, so that
+// repeated temporaries of the same shape do not go back to malloc()/free().
+//
+// Enable it for the whole package with -DCPP11ARMADILLO_USE_POOL in PKG_CPPFLAGS.
+// As with CPP11ARMADILLO_USE_R_ALLOC, the flag must be the same in every translation
+// unit.
+
+#pragma once
+
+#include <cpp11.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#if defined(CPP11ARMADILLO_USE_POOL)
+
+#if defined(CPP11ARMADILLO_USE_R_ALLOC)
+#error "CPP11ARMADILLO_USE_POOL and CPP11ARMADILLO_USE_R_ALLOC cannot be used together"
+#endif
+
+// larger blocks (in bytes) are not cached
+#if !defined(CPP11ARMADILLO_POOL_MAX_BLOCK)
+#define CPP11ARMADILLO_POOL_MAX_BLOCK 4194304
+#endif
+
+// maximum number of bytes cached by each thread
+#if !defined(CPP11ARMADILLO_POOL_CACHE_SIZE)
+#define CPP11ARMADILLO_POOL_CACHE_SIZE 67108864
+#endif
+
+// cached blocks are returned to the system by the next allocation or release of a
+// thread that was idle for this many milliseconds, see MemoryPool::trim()
+#if !defined(CPP11ARMADILLO_POOL_IDLE_TIME)
+#define CPP11ARMADILLO_POOL_IDLE_TIME 1000
+#endif
+
+// thread_local objects with destructors are not reliable on MinGW (see
+// armadillo/arma_rng.hpp), use a single cache with a lock there
+#if (defined(__MINGW32__) || defined(__MINGW64__) || defined(__CYGWIN__))
+#define CPP11ARMADILLO_POOL_SHARED
+#endif
+
+// number of size classes, from 64 bytes to CPP11ARMADILLO_POOL_MAX_BLOCK
+constexpr size_t memory_pool_classes_(const size_t bytes = 64) {
+  return (bytes >= CPP11ARMADILLO_POOL_MAX_BLOCK) ? 1 : 1 + memory_pool_classes_(2 * bytes);
+}
+
+class MemoryPool {
+ public:
+  static void* acquire(const size_t n_bytes) {
+    const size_t k = size_class(n_bytes);
+
+    if (k == unpooled) {
+      count(stats().unpooled);
+      return system_acquire(n_bytes, unpooled);
+    }
+
+    {
+      cache_lock lock;
+      cache& c = local();
+
+      c.touch();
+
+      if (!c.blocks[k].empty()) {
+        void* mem = c.blocks[k].back();
+        c.blocks[k].pop_back();
+        c.bytes -= class_bytes(k);
+        stats().cached_bytes.fetch_sub(class_bytes(k), std::memory_order_relaxed);
+        count(stats().hits);
+        return mem;
+      }
+    }
+
+    count(stats().misses);
+    return system_acquire(class_bytes(k), k);
+  }
+
+  static void release(void* mem) {
+    const size_t k = header(mem)->size_class;
+
+    if (k != unpooled) {
+      cache_lock lock;
+      cache& c = local();
+
+      c.touch();
+
+      if (c.bytes + class_bytes(k) <= CPP11ARMADILLO_POOL_CACHE_SIZE) {
+        c.blocks[k].push_back(mem);
+        c.bytes += class_bytes(k);
+        stats().cached_bytes.fetch_add(class_bytes(k), std::memory_order_relaxed);
+        return;
+      }
+    }
+
+    system_release(mem);
+  }
+
+  // Returns the blocks cached by the calling thread to the system. A cache is also
+  // trimmed by the next acquire() or release() of its thread after
+  // CPP11ARMADILLO_POOL_IDLE_TIME, and when the thread exits. A thread that stops
+  // allocating, such as an OpenMP worker after a parallel region, keeps its blocks
+  // (at most CPP11ARMADILLO_POOL_CACHE_SIZE bytes) until then; call trim() from each
+  // thread, e.g. in a last parallel region, to return them earlier.
+
+  static void trim() {
+    cache_lock lock;
+    local().trim();
+  }
+
+  // Counters since the package was loaded (or the last reset_statistics()):
+  // allocations served from a cache (hits), allocations of a size class that had no
+  // cached block (misses), allocations too large to be pooled (unpooled), the bytes
+  // currently cached by all threads and the bytes returned to the system by trims
+
+  struct snapshot {
+    double hits;
+    double misses;
+    double unpooled;
+    double cached_bytes;
+    double trimmed_bytes;
+  };
+
+  static snapshot counts() {
+    counters& s = stats();
+
+    snapshot out;
+    out.hits = static_cast<double>(s.hits.load(std::memory_order_relaxed));
+    out.misses = static_cast<double>(s.misses.load(std::memory_order_relaxed));
+    out.unpooled = static_cast<double>(s.unpooled.load(std::memory_order_relaxed));
+    out.cached_bytes = static_cast<double>(s.cached_bytes.load(std::memory_order_relaxed));
+    out.trimmed_bytes = static_cast<double>(s.trimmed_bytes.load(std::memory_order_relaxed));
+
+    return out;
+  }
+
+  // The same counters as a named R vector
+
+  static cpp11::writable::doubles statistics() {
+    const snapshot s = counts();
+
+    cpp11::writable::doubles out(
+        {s.hits, s.misses, s.unpooled, s.cached_bytes, s.trimmed_bytes});
+
+    out.attr("names") = cpp11::writable::strings(
+        {"hits", "misses", "unpooled", "cached_bytes", "trimmed_bytes"});
+
+    return out;
+  }
+
+  static void reset_statistics() {
+    counters& s = stats();
+    s.hits.store(0, std::memory_order_relaxed);
+    s.misses.store(0, std::memory_order_relaxed);
+    s.unpooled.store(0, std::memory_order_relaxed);
+    s.trimmed_bytes.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  typedef std::chrono::steady_clock clock;
+
+  // the smallest class holds 64 bytes, class k holds 64 << k bytes
+  static constexpr size_t min_class_bytes = 64;
+
+  static constexpr size_t n_classes = memory_pool_classes_();
+
+  static constexpr size_t unpooled = static_cast<size_t>(-1);
+
+  // The header in front of each block keeps the 32 byte alignment of the memory
+  // returned by Armadillo's own allocator (64 with CPP11ARMADILLO_USE_ALIGN64)
+
+#if defined(CPP11ARMADILLO_USE_ALIGN64)
+  static constexpr size_t header_bytes = 64;
+#else
+  static constexpr size_t header_bytes = 32;
+#endif
+
+  struct block_header {
+    size_t size_class;
+  };
+
+  struct counters {
+    std::atomic<unsigned long long> hits{0};
+    std::atomic<unsigned long long> misses{0};
+    std::atomic<unsigned long long> unpooled{0};
+    std::atomic<unsigned long long> cached_bytes{0};
+    std::atomic<unsigned long long> trimmed_bytes{0};
+  };
+
+  struct cache {
+    std::vector<void*> blocks[n_classes];
+    size_t bytes = 0;
+    clock::time_point last_use = clock::now();
+
+    ~cache() { trim(); }
+
+    void touch() {
+      const clock::time_point now = clock::now();
+
+      if (bytes > 0 &&
+          now - last_use > std::chrono::milliseconds(CPP11ARMADILLO_POOL_IDLE_TIME)) {
+        trim();
+      }
+
+      last_use = now;
+    }
+
+    void trim() {
+      for (size_t k = 0; k < n_classes; ++k) {
+        for (void* mem : blocks[k]) {
+          system_release(mem);
+        }
+
+        blocks[k].clear();
+      }
+
+      stats().cached_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+      stats().trimmed_bytes.fetch_add(bytes, std::memory_order_relaxed);
+      bytes = 0;
+    }
+  };
+
+#if defined(CPP11ARMADILLO_POOL_SHARED)
+  struct cache_lock {
+    std::lock_guard<std::mutex> guard;
+    cache_lock() : guard(mutex()) {}
+  };
+
+  static std::mutex& mutex() {
+    static std::mutex m;
+    return m;
+  }
+
+  static cache& local() {
+    stats();  // constructed first, so that it outlives the cache
+    static cache c;
+    return c;
+  }
+#else
+  // no-op, the constructor only keeps -Wunused-variable quiet
+  struct cache_lock {
+    cache_lock() {}
+  };
+
+  static cache& local() {
+    stats();  // constructed first, so that it outlives the cache
+    thread_local cache c;
+    return c;
+  }
+#endif
+
+  static counters& stats() {
+    static counters s;
+    return s;
+  }
+
+  static void count(std::atomic<unsigned long long>& x) {
+    x.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static size_t class_bytes(const size_t k) { return min_class_bytes << k; }
+
+  static size_t size_class(const size_t n_bytes) {
+    if (n_bytes > CPP11ARMADILLO_POOL_MAX_BLOCK) {
+      return unpooled;
+    }
+
+    size_t k = 0;
+
+    while (class_bytes(k) < n_bytes) {
+      ++k;
+    }
+
+    return k;
+  }
+
+  static block_header* header(void* mem) {
+    return reinterpret_cast<block_header*>(static_cast<char*>(mem) - header_bytes);
+  }
+
+  static void* system_acquire(const size_t n_bytes, const size_t k) {
+    void* base = nullptr;
+
+#if defined(_WIN32)
+    base = _aligned_malloc(n_bytes + header_bytes, header_bytes);
+#else
+    if (posix_memalign(&base, header_bytes, n_bytes + header_bytes) != 0) {
+      base = nullptr;
+    }
+#endif
+
+    if (base == nullptr) {
+      return nullptr;
+    }
+
+    static_cast<block_header*>(base)->size_class = k;
+
+    return static_cast<char*>(base) + header_bytes;
+  }
+
+  static void system_release(void* mem) {
+    void* base = static_cast<char*>(mem) - header_bytes;
+
+#if defined(_WIN32)
+    _aligned_free(base);
+#else
+    std::free(base);
+#endif
+  }
+};
+
+#if !defined(ARMA_ALIEN_MEM_ALLOC_FUNCTION)
+#define ARMA_ALIEN_MEM_ALLOC_FUNCTION ::MemoryPool::acquire
+#define ARMA_ALIEN_MEM_FREE_FUNCTION ::MemoryPool::release
+#endif
+
+#endif
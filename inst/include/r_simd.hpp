@@ -0,0 +1,259 @@
+// Explicit SIMD kernels for element-wise operations on double precision matrices
+// (arithmetic with scalars and between matrices, a % b + c, a * k + b, square(),
+// sqrt(), abs(), the relational operators, exp(), log() and the other elementary
+// functions listed in SimdKernels, and fused normpdf(), log_normpdf() and normcdf()).
+//
+// The kernels are compiled for several instruction sets and the widest one supported
+// by the CPU is selected at run time, so a package built for the baseline (SSE2 on
+// x86-64) still uses AVX2 or AVX-512 when the host has them.
+//
+// The elementary functions are polynomial approximations with an error of at most 2
+// ulp (1 ulp for exp() and log()). Simd::set_accuracy(Simd::strict) goes back to the
+// C library for them, -DCPP11ARMADILLO_STRICT_MATH makes that the default.
+//
+// The kernels are compiled without contracting a * b + c into a fused multiply-add,
+// which GCC does by default for the AVX2 and AVX-512 levels only, so that every level
+// (and -DCPP11ARMADILLO_NO_SIMD) gives the same result on any CPU.
+//
+// Disable it with -DCPP11ARMADILLO_NO_SIMD in PKG_CPPFLAGS.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#if !defined(CPP11ARMADILLO_NO_SIMD) && !defined(__GNUC__)
+#define CPP11ARMADILLO_NO_SIMD
+#endif
+
+#if !defined(CPP11ARMADILLO_NO_SIMD)
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CPP11ARMADILLO_SIMD_X86
+#endif
+
+struct SimdKernels {
+  typedef void (*unary_fn)(double* out, const double* a, const double k, const size_t n);
+  typedef void (*binary_fn)(double* out, const double* a, const double* b,
+                            const size_t n);
+  typedef void (*schur_plus_fn)(double* out, const double* a, const double* b,
+                                const double* c, const size_t n);
+  typedef void (*times_plus_fn)(double* out, const double* a, const double k,
+                                const double* b, const size_t n);
+  typedef void (*relational_fn)(unsigned long long* out, const double* a,
+                                const double* b, const double k, const size_t n);
+  // mu and sigma are taken from mu_k and sigma_k when the pointers are null
+  typedef void (*normal_fn)(double* out, const double* x, const double* mu,
+                            const double* sigma, const double mu_k, const double sigma_k,
+                            const size_t n);
+
+  enum unary_op {
+    neg,
+    plus,
+    minus_pre,
+    minus_post,
+    times,
+    div_pre,
+    div_post,
+    square,
+    sqrt,
+    abs,
+    // approximations, only used in the fast accuracy mode
+    exp,
+    log,
+    exp2,
+    exp10,
+    trunc_exp,
+    log2,
+    log10,
+    trunc_log,
+    sin,
+    cos,
+    tanh,
+    erf,
+    erfc,
+    n_unary
+  };
+
+  enum binary_op { binary_plus, binary_minus, binary_schur, binary_div, n_binary };
+
+  enum relational_op { lt, gt, lteq, gteq, eq, noteq, n_relational };
+
+  enum normal_op { normpdf, log_normpdf, normcdf, n_normal };
+
+  unary_fn unary[n_unary];
+  binary_fn binary[n_binary];
+  schur_plus_fn schur_plus;
+  times_plus_fn times_plus;
+  relational_fn relational[n_relational];
+  normal_fn normal[n_normal];
+};
+
+// a * b + c is rounded twice at every level, see above
+
+#if defined(__clang__)
+#define CPP11ARMADILLO_SIMD_NO_CONTRACT
+#pragma float_control(push)
+#pragma clang fp contract(off)
+#else
+#define CPP11ARMADILLO_SIMD_NO_CONTRACT __attribute__((optimize("fp-contract=off")))
+#endif
+
+namespace cpp11armadillo_simd {
+
+// baseline of the target (SSE2 on x86-64, NEON on arm64)
+namespace generic {
+#define CPP11ARMADILLO_SIMD_BYTES 16
+#define CPP11ARMADILLO_SIMD_TARGET CPP11ARMADILLO_SIMD_NO_CONTRACT
+#if defined(__SSE2__)
+#define CPP11ARMADILLO_SIMD_SQRT(v) _mm_sqrt_pd(v)
+#endif
+#include "r_simd_kernels.hpp"
+#undef CPP11ARMADILLO_SIMD_BYTES
+#undef CPP11ARMADILLO_SIMD_TARGET
+#undef CPP11ARMADILLO_SIMD_SQRT
+}  // namespace generic
+
+#if defined(CPP11ARMADILLO_SIMD_X86)
+namespace avx2 {
+#define CPP11ARMADILLO_SIMD_BYTES 32
+#define CPP11ARMADILLO_SIMD_TARGET \
+  CPP11ARMADILLO_SIMD_NO_CONTRACT __attribute__((target("avx2,fma")))
+#define CPP11ARMADILLO_SIMD_SQRT(v) _mm256_sqrt_pd(v)
+#include "r_simd_kernels.hpp"
+#undef CPP11ARMADILLO_SIMD_BYTES
+#undef CPP11ARMADILLO_SIMD_TARGET
+#undef CPP11ARMADILLO_SIMD_SQRT
+}  // namespace avx2
+
+namespace avx512 {
+#define CPP11ARMADILLO_SIMD_BYTES 64
+#define CPP11ARMADILLO_SIMD_TARGET \
+  CPP11ARMADILLO_SIMD_NO_CONTRACT __attribute__((target("avx512f,avx2,fma")))
+#define CPP11ARMADILLO_SIMD_SQRT(v) _mm512_mask_sqrt_pd(v, 0xff, v)
+#include "r_simd_kernels.hpp"
+#undef CPP11ARMADILLO_SIMD_BYTES
+#undef CPP11ARMADILLO_SIMD_TARGET
+#undef CPP11ARMADILLO_SIMD_SQRT
+}  // namespace avx512
+#endif
+
+}  // namespace cpp11armadillo_simd
+
+#if defined(__clang__)
+#pragma float_control(pop)
+#endif
+
+#undef CPP11ARMADILLO_SIMD_NO_CONTRACT
+
+class Simd {
+ public:
+  enum level_type { generic = 0, avx2 = 1, avx512 = 2 };
+
+  enum accuracy_type { strict = 0, fast = 1 };
+
+  // widest level supported by the CPU (and the operating system)
+
+  static int available() {
+    static const int level = detect();
+    return level;
+  }
+
+  static int level() { return state().level.load(std::memory_order_relaxed); }
+
+  // Selects a narrower level, e.g. to compare results across instruction sets.
+  // Levels above available() are capped. Returns the level in use.
+
+  static int set_level(const int level) {
+    int l = (level < generic) ? generic : level;
+    l = (l > available()) ? available() : l;
+
+    state().level.store(l, std::memory_order_relaxed);
+    state().table.store(&table(l), std::memory_order_relaxed);
+
+    return l;
+  }
+
+  static const char* name(const int level) {
+    switch (level) {
+      case avx2:
+        return "avx2";
+      case avx512:
+        return "avx512";
+      default:
+#if defined(CPP11ARMADILLO_SIMD_X86)
+        return "sse2";
+#else
+        return "generic";
+#endif
+    }
+  }
+
+  // strict: the elementary functions and normpdf(), log_normpdf() and normcdf() use
+  // the C library as without SIMD. fast: they use the kernels (error of at most 2
+  // ulp). Returns the mode in use.
+
+  static int accuracy() { return state().accuracy.load(std::memory_order_relaxed); }
+
+  static int set_accuracy(const int mode) {
+    const int m = (mode == strict) ? strict : fast;
+    state().accuracy.store(m, std::memory_order_relaxed);
+    return m;
+  }
+
+  static bool fast_math() { return accuracy() == fast; }
+
+  static const SimdKernels& kernels() {
+    return *state().table.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct registry {
+    std::atomic<int> level{available()};
+    std::atomic<const SimdKernels*> table{&Simd::table(available())};
+#if defined(CPP11ARMADILLO_STRICT_MATH)
+    std::atomic<int> accuracy{strict};
+#else
+    std::atomic<int> accuracy{fast};
+#endif
+  };
+
+  static registry& state() {
+    static registry st;
+    return st;
+  }
+
+  static const SimdKernels& table(const int level) {
+#if defined(CPP11ARMADILLO_SIMD_X86)
+    if (level == avx512) {
+      return cpp11armadillo_simd::avx512::kernels();
+    }
+
+    if (level == avx2) {
+      return cpp11armadillo_simd::avx2::kernels();
+    }
+#endif
+
+    (void)level;
+    return cpp11armadillo_simd::generic::kernels();
+  }
+
+  static int detect() {
+#if defined(CPP11ARMADILLO_SIMD_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f")) {
+      return avx512;
+    }
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return avx2;
+    }
+#endif
+
+    return generic;
+  }
+};
+
+#endif
@@ -0,0 +1,677 @@
+// Element-wise kernels for one instruction set. r_simd.hpp includes this file once per
+// level, inside its own namespace, after defining
+//
+//   CPP11ARMADILLO_SIMD_BYTES     register width in bytes
+//   CPP11ARMADILLO_SIMD_TARGET    function attribute that enables the instruction set
+//   CPP11ARMADILLO_SIMD_SQRT(v)   square root of a register (optional)
+//
+// The kernels use the vector extensions of GCC and clang, so the same code is
+// compiled for every width. The last partial register of an array goes through the
+// same code as the rest, so that the result of an element does not depend on its
+// position.
+
+// no include guard, see above
+
+typedef double vd __attribute__((vector_size(CPP11ARMADILLO_SIMD_BYTES)));
+typedef long long vl __attribute__((vector_size(CPP11ARMADILLO_SIMD_BYTES)));
+
+constexpr size_t width = CPP11ARMADILLO_SIMD_BYTES / sizeof(double);
+
+#define CPP11ARMADILLO_SIMD_INLINE \
+  CPP11ARMADILLO_SIMD_TARGET __attribute__((always_inline)) inline
+
+CPP11ARMADILLO_SIMD_INLINE vd splat(const double k) { return vd{} + k; }
+
+CPP11ARMADILLO_SIMD_INLINE vl splat_bits(const long long k) { return vl{} + k; }
+
+CPP11ARMADILLO_SIMD_INLINE vd load(const double* p) {
+  vd v;
+  __builtin_memcpy(&v, p, sizeof(vd));
+  return v;
+}
+
+CPP11ARMADILLO_SIMD_INLINE vd load_n(const double* p, const size_t n) {
+  vd v = vd{};
+  __builtin_memcpy(&v, p, n * sizeof(double));
+  return v;
+}
+
+CPP11ARMADILLO_SIMD_INLINE void store(double* p, const vd v) {
+  __builtin_memcpy(p, &v, sizeof(vd));
+}
+
+CPP11ARMADILLO_SIMD_INLINE void store_n(double* p, const vd v, const size_t n) {
+  __builtin_memcpy(p, &v, n * sizeof(double));
+}
+
+CPP11ARMADILLO_SIMD_INLINE void store(unsigned long long* p, const vl v) {
+  __builtin_memcpy(p, &v, sizeof(vl));
+}
+
+CPP11ARMADILLO_SIMD_INLINE void store_n(unsigned long long* p, const vl v, const size_t n) {
+  __builtin_memcpy(p, &v, n * sizeof(unsigned long long));
+}
+
+// lanes of a where the mask is set, lanes of b elsewhere
+CPP11ARMADILLO_SIMD_INLINE vd select(const vl mask, const vd a, const vd b) {
+  return (vd)((mask & (vl)a) | (~mask & (vl)b));
+}
+
+// exact for |k| < 2^51
+CPP11ARMADILLO_SIMD_INLINE vd to_double(const vl k) {
+  return (vd)(k + splat_bits(0x4338000000000000LL)) - splat(6755399441055744.0);
+}
+
+CPP11ARMADILLO_SIMD_INLINE vd sqrt_v(const vd v) {
+#if defined(CPP11ARMADILLO_SIMD_SQRT)
+  return CPP11ARMADILLO_SIMD_SQRT(v);
+#else
+  vd out;
+  for (size_t j = 0; j < width; ++j) {
+    out[j] = __builtin_sqrt(v[j]);
+  }
+  return out;
+#endif
+}
+
+CPP11ARMADILLO_SIMD_INLINE vd copysign_v(const vd mag, const vd sgn) {
+  const vl sign_bit = splat_bits(0x8000000000000000LL);
+  return (vd)(((vl)mag & ~sign_bit) | ((vl)sgn & sign_bit));
+}
+
+CPP11ARMADILLO_SIMD_INLINE bool any(const vl mask) {
+  long long out = 0;
+  for (size_t j = 0; j < width; ++j) {
+    out |= mask[j];
+  }
+  return out != 0;
+}
+
+CPP11ARMADILLO_SIMD_INLINE vd poly(const vd x, const double c0, const double c1) {
+  return splat(c0) + x * splat(c1);
+}
+
+template <typename... C>
+CPP11ARMADILLO_SIMD_INLINE vd poly(const vd x, const double c0, const double c1,
+                                   const C... c) {
+  return splat(c0) + x * poly(x, c1, c...);
+}
+
+// The elementary functions follow fdlibm (error below 1 ulp for exp() and log()),
+// with the special cases handled by masks instead of branches. The other functions
+// are within 2 ulp.
+
+// 2^k * exp(hi - lo) for |hi - lo| <= ln(2) / 2, see e_exp.c
+
+CPP11ARMADILLO_SIMD_INLINE vd exp_core(const vd hi, const vd lo, const vl k) {
+  const vd r = hi - lo;
+  const vd r2 = r * r;
+  const vd c = r - r2 * poly(r2, 1.66666666666666019037e-01, -2.77777777770155933842e-03,
+                             6.61375632143793436117e-05, -1.65339022054652515390e-06,
+                             4.13813679705723846039e-08);
+
+  vd y = splat(1.0) - ((lo - (r * c) / (splat(2.0) - c)) - hi);
+
+  // 2^k in two steps, so that subnormal results are rounded once
+  const vl k1 = k >> 1;
+  const vl k2 = k - k1;
+
+  y = y * (vd)((k1 + 1023) << 52);
+  y = y * (vd)((k2 + 1023) << 52);
+
+  return y;
+}
+
+CPP11ARMADILLO_SIMD_INLINE vd exp_v(const vd x) {
+  const vd shift = splat(6755399441055744.0);  // 1.5 * 2^52, rounds to an integer
+
+  vd xc = select((vl)(x > splat(710.0)), splat(710.0), x);
+  xc = select((vl)(xc < splat(-746.0)), splat(-746.0), xc);
+
+  // x = k * ln(2) + r, |r| <= ln(2) / 2
+  const vd t = xc * splat(1.44269504088896338700e+00) + shift;
+  const vd kd = t - shift;
+  const vl k = (vl)t - (vl)shift;
+
+  const vd hi = xc - kd * splat(6.93147180369123816490e-01);
+  const vd lo = kd * splat(1.90821492927058770002e-10);
+
+  vd y = exp_core(hi, lo, k);
+
+  y = select((vl)(x > splat(7.09782712893383973096e+02)), splat(__builtin_inf()), y);
+  y = select((vl)(x < splat(-7.45133219101941108420e+02)), splat(0.0), y);
+  y = select((vl)(x != x), x, y);
+
+  return y;
+}
+
+// 2^x = 2^k * exp(r * ln(2)), r = x - k is exact. Results out of range overflow or
+// underflow in exp_core()
+
+CPP11ARMADILLO_SIMD_INLINE vd exp2_v(const vd x) {
+  const vd shift = splat(6755399441055744.0);
+
+  vd xc = select((vl)(x > splat(1030.0)), splat(1030.0), x);
+  xc = select((vl)(xc < splat(-1080.0)), splat(-1080.0), xc);
+
+  const vd t = xc + shift;
+  const vd kd = t - shift;
+  const vl k = (vl)t - (vl)shift;
+
+  const vd y = exp_core((xc - kd) * splat(6.93147180559945286227e-01), splat(0.0), k);
+
+  return select((vl)(x != x), x, y);
+}
+
+// 10^x = 2^k * exp(r * ln(10)), r = x - k * log10(2)
+
+CPP11ARMADILLO_SIMD_INLINE vd exp10_v(const vd x) {
+  const vd shift = splat(6755399441055744.0);
+
+  vd xc = select((vl)(x > splat(310.0)), splat(310.0), x);
+  xc = select((vl)(xc < splat(-330.0)), splat(-330.0), xc);
+
+  const vd t = xc * splat(3.32192809488736218171e+00) + shift;
+  const vd kd = t - shift;
+  const vl k = (vl)t - (vl)shift;
+
+  const vd r = (xc - kd * splat(3.01029995663611771306e-01)) -
+               kd * splat(3.69423907715893078616e-13);
+
+  const vd y = exp_core(r * splat(2.30258509299404568402e+00), splat(0.0), k);
+
+  return select((vl)(x != x), x, y);
+}
+
+// x = 2^k * (1 + f), sqrt(2) / 2 <= 1 + f < sqrt(2), and
+// log(1 + f) = f - hfsq + r, see e_log.c and k_log.h
+
+struct log_parts {
+  vd kd;
+  vd f;
+  vd hfsq;
+  vd r;
+};
+
+CPP11ARMADILLO_SIMD_INLINE log_parts log_reduce(const vd x) {
+  // subnormal inputs are scaled by 2^54
+  const vl sub = (vl)(x < splat(2.2250738585072014e-308));
+  const vd xs = select(sub, x * splat(18014398509481984.0), x);
+  const vl bits = (vl)xs;
+
+  vl e = ((bits >> 52) & 0x7ff) - 1023 - (sub & 54);
+
+  vd m = (vd)((bits & 0x000fffffffffffffLL) | 0x3ff0000000000000LL);
+  const vl big = (vl)(m > splat(1.41421356237309504880));
+  m = select(big, m * splat(0.5), m);
+  e = e - big;
+
+  log_parts out;
+
+  out.f = m - splat(1.0);
+
+  const vd s = out.f / (splat(2.0) + out.f);
+  const vd z = s * s;
+  const vd w = z * z;
+  const vd t1 = w * poly(w, 3.999999999940941908e-01, 2.222219843214978396e-01,
+                         1.531383769920937332e-01);
+  const vd t2 = z * poly(w, 6.666666666666735130e-01, 2.857142874366239149e-01,
+                         1.818357216161805012e-01, 1.479819860511658591e-01);
+
+  out.hfsq = splat(0.5) * out.f * out.f;
+  out.r = s * (out.hfsq + t1 + t2);
+  out.kd = to_double(e);
+
+  return out;
+}
+
+// log(+inf) = +inf, log(0) = -inf, log(x < 0) = NaN
+
+CPP11ARMADILLO_SIMD_INLINE vd log_special(const vd x, vd y) {
+  y = select((vl)(x == splat(__builtin_inf())), x, y);
+  y = select((vl)(x == splat(0.0)), splat(-__builtin_inf()), y);
+  y = select((vl)(x < splat(0.0)), splat(__builtin_nan("")), y);
+  y = select((vl)(x != x), x, y);
+
+  return y;
+}
+
+CPP11ARMADILLO_SIMD_INLINE vd log_v(const vd x) {
+  const log_parts p = log_reduce(x);
+
+  const vd y =
+      p.kd * splat(6.93147180369123816490e-01) -
+      ((p.hfsq - (p.r + p.kd * splat(1.90821492927058770002e-10))) - p.f);
+
+  return log_special(x, y);
+}
+
+// log2() and log10() split f - hfsq in two parts to keep the extra precision, see
+// e_log2.c and e_log10.c
+
+CPP11ARMADILLO_SIMD_INLINE vd log2_v(const vd x) {
+  const log_parts p = log_reduce(x);
+
+  const vd hi = (vd)((vl)(p.f - p.hfsq) & splat_bits(0xffffffff00000000LL));
+  const vd lo = ((p.f - hi) - p.hfsq) + p.r;
+
+  vd val_hi = hi * splat(1.44269504072144627571e+00);
+  vd val_lo = (lo + hi) * splat(1.67517131648865118353e-10) +
+              lo * splat(1.44269504072144627571e+00);
+
+  const vd w = p.kd + val_hi;
+  val_lo = val_lo + ((p.kd - w) + val_hi);
+  val_hi = w;
+
+  return log_special(x, val_lo + val_hi);
+}
+
+CPP11ARMADILLO_SIMD_INLINE vd log10_v(const vd x) {
+  const log_parts p = log_reduce(x);
+
+  const vd hi = (vd)((vl)(p.f - p.hfsq) & splat_bits(0xffffffff00000000LL));
+  const vd lo = ((p.f - hi) - p.hfsq) + p.r;
+
+  vd val_hi = hi * splat(4.34294481878168880939e-01);
+  const vd y2 = p.kd * splat(3.01029995663611771306e-01);
+  vd val_lo = p.kd * splat(3.69423907715893078616e-13) +
+              (lo + hi) * splat(2.50829467116452752298e-11) +
+              lo * splat(4.34294481878168880939e-01);
+
+  const vd w = y2 + val_hi;
+  val_lo = val_lo + ((y2 - w) + val_hi);
+  val_hi = w;
+
+  return log_special(x, val_lo + val_hi);
+}
+
+// sin() and cos() reduce x to y0 + y1 in [-pi/4, pi/4] with pi/2 in three parts of 33
+// bits (e_rem_pio2.c), exact for |x| < 2^20 * pi/2. Larger arguments, infinities and
+// NaN go to the C library.
+
+CPP11ARMADILLO_SIMD_INLINE vd k_sin(const vd x, const vd y) {
+  const vd z = x * x;
+  const vd v = z * x;
+  const vd r = poly(z, 8.33333333332248946124e-03, -1.98412698298579493134e-04,
+                    2.75573137070700676789e-06, -2.50507602534068634195e-08,
+                    1.58969099521155010221e-10);
+
+  return x - ((z * (splat(0.5) * y - v * r) - y) - v * splat(-1.66666666666666324348e-01));
+}
+
+CPP11ARMADILLO_SIMD_INLINE vd k_cos(const vd x, const vd y) {
+  const vd z = x * x;
+  const vd r = z * poly(z, 4.16666666666666019037e-02, -1.38888888888741095749e-03,
+                        2.48015872894767294178e-05, -2.75573143513906633035e-07,
+                        2.08757232129817482790e-09, -1.13596475577881948265e-11);
+  const vd hz = splat(0.5) * z;
+  const vd w = splat(1.0) - hz;
+
+  return w + (((splat(1.0) - w) - hz) + (z * r - x * y));
+}
+
+template <bool is_cos>
+CPP11ARMADILLO_SIMD_INLINE vd sincos_v(const vd x) {
+  const vd shift = splat(6755399441055744.0);
+
+  const vl large = (vl)(!((vd)((vl)x & 0x7fffffffffffffffLL) < splat(1.6e6)));
+  const vd xr = select(large, splat(0.0), x);
+
+  const vd t = xr * splat(6.36619772367581382433e-01) + shift;
+  const vd n = t - shift;
+  const vl q = (vl)t - (vl)shift + (is_cos ? 1 : 0);
+
+  vd r = xr - n * splat(1.57079632673412561417e+00);
+  vd u = r;
+  vd w = n * splat(6.07710050630396597660e-11);
+
+  r = u - w;
+  w = n * splat(2.02226624879595063154e-21) - ((u - r) - w);
+
+  u = r;
+  w = n * splat(2.02226624871116645580e-21);
+  r = u - w;
+  w = n * splat(8.47842766036889956997e-32) - ((u - r) - w);
+
+  const vd y0 = r - w;
+  const vd y1 = (r - y0) - w;
+
+  // quadrant q: sin, cos, -sin, -cos (cos(x) = sin(x + pi/2))
+  vd y = select((vl)((q & 1) != 0), k_cos(y0, y1), k_sin(y0, y1));
+  y = (vd)((vl)y ^ ((q & 2) << 62));
+
+  if (any(large)) {
+    for (size_t j = 0; j < width; ++j) {
+      if (large[j]) {
+        y[j] = is_cos ? __builtin_cos(x[j]) : __builtin_sin(x[j]);
+      }
+    }
+  }
+
+  return y;
+}
+
+// tanh() as in Cephes, 1 - 2 / (exp(2|x|) + 1) for |x| >= 0.625 and a rational
+// approximation below
+
+CPP11ARMADILLO_SIMD_INLINE vd tanh_v(const vd x) {
+  const vd ax = (vd)((vl)x & 0x7fffffffffffffffLL);
+
+  // the rational approximation is x + (+0) for -0.0, copysign() keeps the zero negative
+  const vd s = x * x;
+  const vd small = copysign_v(
+      x + x * s * poly(s, -1.61468768441708447952e+03, -9.92877231001918586564e+01,
+                       -9.64399179425052238628e-01) /
+              poly(s, 4.84406305325125486048e+03, 2.23548839060100448583e+03,
+                   1.12811678491632931402e+02, 1.0),
+      x);
+
+  const vd e = exp_v(splat(2.0) * ax);
+  const vd large = copysign_v(splat(1.0) - splat(2.0) / (e + splat(1.0)), x);
+
+  return select((vl)(ax >= splat(0.625)), large, small);
+}
+
+// erf() and erfc() follow s_erf.c, the intervals of |x| that are not present in the
+// register are skipped
+
+template <bool is_erfc>
+CPP11ARMADILLO_SIMD_INLINE vd erf_v(const vd x) {
+  const vd ax = (vd)((vl)x & 0x7fffffffffffffffLL);
+  const vd one = splat(1.0);
+  const vd erx = splat(8.45062911510467529297e-01);
+
+  // |x| < 0.84375
+  const vd z = x * x;
+  const vd y = poly(z, 1.28379167095512558561e-01, -3.25042107247001499370e-01,
+                    -2.84817495755985104766e-02, -5.77027029648944159157e-03,
+                    -2.37630166566501626084e-05) /
+               poly(z, 1.0, 3.97917223959155352819e-01, 6.50222499887672944485e-02,
+                    5.08130628187576562776e-03, 1.32494738004321644526e-04,
+                    -3.96022827877536812320e-06);
+
+  vd out;
+
+  if (is_erfc) {
+    out = select((vl)(x < splat(0.25)), one - (x + x * y),
+                 splat(0.5) - (x * y + (x - splat(0.5))));
+  } else {
+    out = x + x * y;
+  }
+
+  // 0.84375 <= |x| < 1.25
+  const vl mid = (vl)(ax >= splat(0.84375)) & (vl)(ax < splat(1.25));
+
+  if (any(mid)) {
+    const vd s = ax - one;
+    const vd pq = poly(s, -2.36211856075265944077e-03, 4.14856118683748331666e-01,
+                       -3.72207876035701323847e-01, 3.18346619901161753674e-01,
+                       -1.10894694282396677476e-01, 3.54783043256182359371e-02,
+                       -2.16637559486879084300e-03) /
+                  poly(s, 1.0, 1.06420880400844228286e-01, 5.40397917702171048937e-01,
+                       7.18286544141962662868e-02, 1.26171219808761642112e-01,
+                       1.36370839120290507362e-02, 1.19844998467991074170e-02);
+
+    vd v;
+
+    if (is_erfc) {
+      v = select((vl)(x > splat(0.0)), (one - erx) - pq, one + (erx + pq));
+    } else {
+      v = copysign_v(erx + pq, x);
+    }
+
+    out = select(mid, v, out);
+  }
+
+  // 1.25 <= |x| < 28 (the remaining values of erf() are +-1)
+  const vl far = (vl)(ax >= splat(1.25)) & (vl)(ax < splat(is_erfc ? 28.0 : 6.0));
+
+  if (any(far)) {
+    const vd s = one / (ax * ax);
+    const vl a = (vl)(ax < splat(1.0 / 0.35));
+
+    // [1.25, 1 / 0.35) and [1 / 0.35, 28)
+    const vd R = select(a,
+                        poly(s, -9.86494403484714822705e-03, -6.93858572707181764372e-01,
+                             -1.05586262253232909814e+01, -6.23753324503260060396e+01,
+                             -1.62396669462573470355e+02, -1.84605092906711035994e+02,
+                             -8.12874355063065934246e+01, -9.81432934416914548592e+00),
+                        poly(s, -9.86494292470009928597e-03, -7.99283237680523006574e-01,
+                             -1.77579549177547519889e+01, -1.60636384855821916062e+02,
+                             -6.37566443368389627722e+02, -1.02509513161107724954e+03,
+                             -4.83519191608651397019e+02));
+    const vd S = select(
+        a,
+        poly(s, 1.0, 1.96512716674392571292e+01, 1.37657754143519042600e+02,
+             4.34565877475229228821e+02, 6.45387271733267880336e+02,
+             4.29008140027567833386e+02, 1.08635005541779435134e+02,
+             6.57024977031928170135e+00, -6.04244152148580987438e-02),
+        poly(s, 1.0, 3.03380607434824582924e+01, 3.25792512996573918826e+02,
+             1.53672958608443695994e+03, 3.19985821950859553908e+03,
+             2.55305040643316442583e+03, 4.74528541206955367215e+02,
+             -2.24409524465858183362e+01));
+
+    // exp(-x^2 - 0.5625 + R / S), with x^2 split in an exact part (the high bits of
+    // |x| squared) and a small one, which are only added after the range reduction
+    const vd shift = splat(6755399441055744.0);
+    const vd zh = (vd)((vl)ax & splat_bits(0xffffffff00000000LL));
+    const vd e1 = -zh * zh - splat(0.5625);
+    const vd e2 = (zh - ax) * (zh + ax) + R / S;
+
+    const vd t = (e1 + e2) * splat(1.44269504088896338700e+00) + shift;
+    const vd kd = t - shift;
+    const vl k = (vl)t - (vl)shift;
+
+    const vd r = exp_core((e1 - kd * splat(6.93147180369123816490e-01)) + e2,
+                          kd * splat(1.90821492927058770002e-10), k);
+
+    vd v;
+
+    if (is_erfc) {
+      v = select((vl)(x > splat(0.0)), r / ax, splat(2.0) - r / ax);
+    } else {
+      v = copysign_v(one - r / ax, x);
+    }
+
+    out = select(far, v, out);
+  }
+
+  // the tails
+  if (is_erfc) {
+    out = select((vl)(x >= splat(28.0)), splat(0.0), out);
+    out = select((vl)(x <= splat(-6.0)), splat(2.0), out);
+  } else {
+    out = select((vl)(ax >= splat(6.0)), copysign_v(one, x), out);
+  }
+
+  return select((vl)(x != x), x, out);
+}
+
+// out = f(a, k)
+
+#define CPP11ARMADILLO_SIMD_UNARY(name, expr)                                         \
+  inline CPP11ARMADILLO_SIMD_TARGET void name(double* out, const double* a,           \
+                                              const double k_, const size_t n) {      \
+    const vd k = splat(k_);                                                           \
+    (void)k;                                                                          \
+    size_t i = 0;                                                                     \
+    for (; i + width <= n; i += width) {                                              \
+      const vd v = load(a + i);                                                       \
+      store(out + i, (expr));                                                         \
+    }                                                                                 \
+    if (i < n) {                                                                      \
+      const vd v = load_n(a + i, n - i);                                              \
+      store_n(out + i, (expr), n - i);                                                \
+    }                                                                                 \
+  }
+
+CPP11ARMADILLO_SIMD_UNARY(unary_neg, -v)
+CPP11ARMADILLO_SIMD_UNARY(unary_plus, v + k)
+CPP11ARMADILLO_SIMD_UNARY(unary_minus_pre, k - v)
+CPP11ARMADILLO_SIMD_UNARY(unary_minus_post, v - k)
+CPP11ARMADILLO_SIMD_UNARY(unary_times, v * k)
+CPP11ARMADILLO_SIMD_UNARY(unary_div_pre, k / v)
+CPP11ARMADILLO_SIMD_UNARY(unary_div_post, v / k)
+CPP11ARMADILLO_SIMD_UNARY(unary_square, v * v)
+CPP11ARMADILLO_SIMD_UNARY(unary_sqrt, sqrt_v(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_abs, (vd)((vl)v & 0x7fffffffffffffffLL))
+CPP11ARMADILLO_SIMD_UNARY(unary_exp, exp_v(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_log, log_v(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_exp2, exp2_v(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_exp10, exp10_v(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_trunc_exp,
+                          select((vl)(v >= splat(7.09782712893383973096e+02)),
+                                 splat(1.79769313486231570815e+308), exp_v(v)))
+CPP11ARMADILLO_SIMD_UNARY(unary_log2, log2_v(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_log10, log10_v(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_trunc_log,
+                          select((vl)(v == splat(__builtin_inf())),
+                                 splat(7.09782712893383973096e+02),
+                                 select((vl)(v <= splat(0.0)),
+                                        splat(-7.08396418532264078749e+02), log_v(v))))
+CPP11ARMADILLO_SIMD_UNARY(unary_sin, sincos_v<false>(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_cos, sincos_v<true>(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_tanh, tanh_v(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_erf, erf_v<false>(v))
+CPP11ARMADILLO_SIMD_UNARY(unary_erfc, erf_v<true>(v))
+
+#undef CPP11ARMADILLO_SIMD_UNARY
+
+// out = a op b
+
+#define CPP11ARMADILLO_SIMD_BINARY(name, op)                                          \
+  inline CPP11ARMADILLO_SIMD_TARGET void name(double* out, const double* a,           \
+                                              const double* b, const size_t n) {      \
+    size_t i = 0;                                                                     \
+    for (; i + width <= n; i += width) {                                              \
+      store(out + i, load(a + i) op load(b + i));                                     \
+    }                                                                                 \
+    if (i < n) {                                                                      \
+      store_n(out + i, load_n(a + i, n - i) op load_n(b + i, n - i), n - i);          \
+    }                                                                                 \
+  }
+
+CPP11ARMADILLO_SIMD_BINARY(binary_plus, +)
+CPP11ARMADILLO_SIMD_BINARY(binary_minus, -)
+CPP11ARMADILLO_SIMD_BINARY(binary_schur, *)
+CPP11ARMADILLO_SIMD_BINARY(binary_div, /)
+
+#undef CPP11ARMADILLO_SIMD_BINARY
+
+// out = a % b + c
+
+inline CPP11ARMADILLO_SIMD_TARGET void fused_schur_plus(double* out, const double* a,
+                                                        const double* b, const double* c,
+                                                        const size_t n) {
+  size_t i = 0;
+  for (; i + width <= n; i += width) {
+    store(out + i, load(a + i) * load(b + i) + load(c + i));
+  }
+  if (i < n) {
+    const size_t m = n - i;
+    store_n(out + i, load_n(a + i, m) * load_n(b + i, m) + load_n(c + i, m), m);
+  }
+}
+
+// out = a * k + b
+
+inline CPP11ARMADILLO_SIMD_TARGET void fused_times_plus(double* out, const double* a,
+                                                        const double k_, const double* b,
+                                                        const size_t n) {
+  const vd k = splat(k_);
+  size_t i = 0;
+  for (; i + width <= n; i += width) {
+    store(out + i, load(a + i) * k + load(b + i));
+  }
+  if (i < n) {
+    const size_t m = n - i;
+    store_n(out + i, load_n(a + i, m) * k + load_n(b + i, m), m);
+  }
+}
+
+// out = (a op b) as 0 or 1, or (a op k) when b is null
+
+#define CPP11ARMADILLO_SIMD_RELATIONAL(name, op)                                      \
+  inline CPP11ARMADILLO_SIMD_TARGET void name(unsigned long long* out, const double* a, \
+                                              const double* b, const double k_,       \
+                                              const size_t n) {                       \
+    const vd k = splat(k_);                                                           \
+    const vl one = splat_bits(1);                                                     \
+    size_t i = 0;                                                                     \
+    for (; i + width <= n; i += width) {                                              \
+      const vd y = (b != nullptr) ? load(b + i) : k;                                  \
+      store(out + i, (vl)(load(a + i) op y) & one);                                   \
+    }                                                                                 \
+    if (i < n) {                                                                      \
+      const size_t m = n - i;                                                         \
+      const vd y = (b != nullptr) ? load_n(b + i, m) : k;                             \
+      store_n(out + i, (vl)(load_n(a + i, m) op y) & one, m);                         \
+    }                                                                                 \
+  }
+
+CPP11ARMADILLO_SIMD_RELATIONAL(relational_lt, <)
+CPP11ARMADILLO_SIMD_RELATIONAL(relational_gt, >)
+CPP11ARMADILLO_SIMD_RELATIONAL(relational_lteq, <=)
+CPP11ARMADILLO_SIMD_RELATIONAL(relational_gteq, >=)
+CPP11ARMADILLO_SIMD_RELATIONAL(relational_eq, ==)
+CPP11ARMADILLO_SIMD_RELATIONAL(relational_noteq, !=)
+
+#undef CPP11ARMADILLO_SIMD_RELATIONAL
+
+// out = f(x, mu, sigma), with the same operations as fn_normpdf.hpp,
+// fn_log_normpdf.hpp and fn_normcdf.hpp
+
+#define CPP11ARMADILLO_SIMD_NORMAL(name, expr)                                        \
+  inline CPP11ARMADILLO_SIMD_TARGET void name(                                        \
+      double* out, const double* x, const double* mu, const double* sigma,            \
+      const double mu_k, const double sigma_k, const size_t n) {                      \
+    const vd mk = splat(mu_k);                                                        \
+    const vd sk = splat(sigma_k);                                                     \
+    const vd log_sk = log_v(sk);                                                      \
+    (void)log_sk;                                                                     \
+    size_t i = 0;                                                                     \
+    for (; i + width <= n; i += width) {                                              \
+      const vd v = load(x + i);                                                       \
+      const vd m = (mu != nullptr) ? load(mu + i) : mk;                               \
+      const vd s = (sigma != nullptr) ? load(sigma + i) : sk;                         \
+      store(out + i, (expr));                                                         \
+    }                                                                                 \
+    if (i < n) {                                                                      \
+      const size_t l = n - i;                                                         \
+      const vd v = load_n(x + i, l);                                                  \
+      const vd m = (mu != nullptr) ? load_n(mu + i, l) : mk;                          \
+      const vd s = (sigma != nullptr) ? load_n(sigma + i, l) : sk;                    \
+      store_n(out + i, (expr), l);                                                    \
+    }                                                                                 \
+  }
+
+CPP11ARMADILLO_SIMD_NORMAL(normal_pdf,
+                           exp_v(splat(-0.5) * (((v - m) / s) * ((v - m) / s))) /
+                               (s * splat(2.50662827463100050242e+00)))
+CPP11ARMADILLO_SIMD_NORMAL(normal_log_pdf,
+                           (splat(-0.5) * (((v - m) / s) * ((v - m) / s))) -
+                               (((sigma != nullptr) ? log_v(s) : log_sk) +
+                                splat(9.18938533204672741780e-01)))
+CPP11ARMADILLO_SIMD_NORMAL(normal_cdf,
+                           splat(0.5) * erf_v<true>((v - m) /
+                                                    (s * splat(-1.41421356237309504880))))
+
+#undef CPP11ARMADILLO_SIMD_NORMAL
+
+inline const SimdKernels& kernels() {
+  static const SimdKernels table = {
+      {unary_neg, unary_plus, unary_minus_pre, unary_minus_post, unary_times,
+       unary_div_pre, unary_div_post, unary_square, unary_sqrt, unary_abs, unary_exp,
+       unary_log, unary_exp2, unary_exp10, unary_trunc_exp, unary_log2, unary_log10,
+       unary_trunc_log, unary_sin, unary_cos, unary_tanh, unary_erf, unary_erfc},
+      {binary_plus, binary_minus, binary_schur, binary_div},
+      fused_schur_plus,
+      fused_times_plus,
+      {relational_lt, relational_gt, relational_lteq, relational_gteq, relational_eq,
+       relational_noteq},
+      {normal_pdf, normal_log_pdf, normal_cdf}};
+
+  return table;
+}
+
+#undef CPP11ARMADILLO_SIMD_INLINE
@@ -0,0 +1,385 @@
+// Opt-in telemetry for profiling from R: memory::acquire()/release() calls and bytes
+// per thread, and the time spent in the main entry points (matrix products, solvers,
+// eig_sym(), sort() and loading from disk).
+//
+// Enable it for the whole package with -DCPP11ARMADILLO_USE_TELEMETRY in
+// PKG_CPPFLAGS. It is compiled out otherwise.
+//
+// The size of each block is kept in one of several maps picked by its address, and
+// the counters and timed calls in records of the calling thread, so threads only
+// meet on the same lock when they use blocks of the same map. The records are merged
+// when they are reported.
+
+#pragma once
+
+#include <cpp11.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(CPP11ARMADILLO_USE_TELEMETRY)
+
+// timed calls kept for the trace, later calls are only counted
+#if !defined(CPP11ARMADILLO_TELEMETRY_MAX_EVENTS)
+#define CPP11ARMADILLO_TELEMETRY_MAX_EVENTS 100000
+#endif
+
+// number of maps for the sizes of the blocks in use
+#if !defined(CPP11ARMADILLO_TELEMETRY_SHARDS)
+#define CPP11ARMADILLO_TELEMETRY_SHARDS 64
+#endif
+
+class Telemetry {
+ public:
+  typedef std::chrono::steady_clock clock;
+
+  static void on_acquire(const void* mem, const size_t n_bytes) {
+    if (mem == nullptr) {
+      return;
+    }
+
+    {
+      shard& sh = shard_of(mem);
+      std::lock_guard<std::mutex> lock(sh.mutex);
+      sh.sizes[mem] = n_bytes;
+    }
+
+    thread_stats& t = local();
+    t.acquires.fetch_add(1, std::memory_order_relaxed);
+    t.bytes_acquired.fetch_add(n_bytes, std::memory_order_relaxed);
+    t.update_peak(static_cast<long long>(n_bytes));
+
+    total().update_peak(static_cast<long long>(n_bytes));
+  }
+
+  static void on_release(const void* mem) {
+    size_t n_bytes = 0;
+
+    {
+      shard& sh = shard_of(mem);
+      std::lock_guard<std::mutex> lock(sh.mutex);
+
+      auto it = sh.sizes.find(mem);
+
+      if (it != sh.sizes.end()) {
+        n_bytes = it->second;
+        sh.sizes.erase(it);
+      }
+    }
+
+    thread_stats& t = local();
+    t.releases.fetch_add(1, std::memory_order_relaxed);
+    t.bytes_released.fetch_add(n_bytes, std::memory_order_relaxed);
+    t.live.fetch_sub(static_cast<long long>(n_bytes), std::memory_order_relaxed);
+
+    total().live.fetch_sub(static_cast<long long>(n_bytes), std::memory_order_relaxed);
+  }
+
+  static void on_call(const char* name, const clock::time_point start,
+                      const clock::time_point end) {
+    const double dur = std::chrono::duration<double, std::micro>(end - start).count();
+
+    registry& reg = instance();
+    thread_stats& t = local();
+
+    // only taken by another thread while reporting
+    std::lock_guard<std::mutex> lock(t.mutex);
+
+    call_stats& s = t.calls[name];
+    s.calls += 1;
+    s.total_us += dur;
+    s.max_us = (dur > s.max_us) ? dur : s.max_us;
+
+    if (reg.n_events.fetch_add(1, std::memory_order_relaxed) <
+        CPP11ARMADILLO_TELEMETRY_MAX_EVENTS) {
+      const clock::duration origin(reg.origin.load(std::memory_order_relaxed));
+      const double ts =
+          std::chrono::duration<double, std::micro>(start.time_since_epoch() - origin)
+              .count();
+      t.events.push_back({name, t.id, ts, dur});
+    }
+  }
+
+  // One row per thread that used Armadillo memory, and a last row (thread = NA) for
+  // the whole process. peak_bytes is the largest amount of memory acquired and not
+  // yet released.
+
+  static cpp11::writable::data_frame memory() {
+    registry& reg = instance();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    const R_xlen_t n = static_cast<R_xlen_t>(reg.threads.size()) + 1;
+
+    cpp11::writable::integers thread(n);
+    cpp11::writable::doubles acquires(n), releases(n), bytes_acquired(n),
+        bytes_released(n), peak_bytes(n);
+
+    double a = 0, r = 0, ba = 0, br = 0;
+
+    for (R_xlen_t i = 0; i < n - 1; ++i) {
+      const thread_stats& t = *reg.threads[i];
+
+      const double ai = static_cast<double>(t.acquires.load(std::memory_order_relaxed));
+      const double ri = static_cast<double>(t.releases.load(std::memory_order_relaxed));
+      const double bai =
+          static_cast<double>(t.bytes_acquired.load(std::memory_order_relaxed));
+      const double bri =
+          static_cast<double>(t.bytes_released.load(std::memory_order_relaxed));
+
+      thread[i] = t.id;
+      acquires[i] = ai;
+      releases[i] = ri;
+      bytes_acquired[i] = bai;
+      bytes_released[i] = bri;
+      peak_bytes[i] = static_cast<double>(t.peak.load(std::memory_order_relaxed));
+
+      a += ai;
+      r += ri;
+      ba += bai;
+      br += bri;
+    }
+
+    thread[n - 1] = NA_INTEGER;
+    acquires[n - 1] = a;
+    releases[n - 1] = r;
+    bytes_acquired[n - 1] = ba;
+    bytes_released[n - 1] = br;
+    peak_bytes[n - 1] = static_cast<double>(total().peak.load(std::memory_order_relaxed));
+
+    return cpp11::writable::data_frame({cpp11::named_arg("thread") = thread,
+                                        cpp11::named_arg("acquires") = acquires,
+                                        cpp11::named_arg("releases") = releases,
+                                        cpp11::named_arg("bytes_acquired") = bytes_acquired,
+                                        cpp11::named_arg("bytes_released") = bytes_released,
+                                        cpp11::named_arg("peak_bytes") = peak_bytes});
+  }
+
+  // One row per timed entry point, times in milliseconds
+
+  static cpp11::writable::data_frame operations() {
+    registry& reg = instance();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    // the same name can come from several threads (and translation units)
+    std::map<std::string, call_stats> merged;
+
+    for (auto& t : reg.threads) {
+      std::lock_guard<std::mutex> thread_lock(t->mutex);
+
+      for (const auto& kv : t->calls) {
+        call_stats& s = merged[kv.first];
+        s.calls += kv.second.calls;
+        s.total_us += kv.second.total_us;
+        s.max_us = (kv.second.max_us > s.max_us) ? kv.second.max_us : s.max_us;
+      }
+    }
+
+    const R_xlen_t n = static_cast<R_xlen_t>(merged.size());
+
+    cpp11::writable::strings name(n);
+    cpp11::writable::doubles calls(n), total_ms(n), mean_ms(n), max_ms(n);
+
+    R_xlen_t i = 0;
+
+    for (const auto& kv : merged) {
+      name[i] = kv.first;
+      calls[i] = kv.second.calls;
+      total_ms[i] = kv.second.total_us / 1000.0;
+      mean_ms[i] = kv.second.total_us / 1000.0 / kv.second.calls;
+      max_ms[i] = kv.second.max_us / 1000.0;
+      ++i;
+    }
+
+    return cpp11::writable::data_frame(
+        {cpp11::named_arg("name") = name, cpp11::named_arg("calls") = calls,
+         cpp11::named_arg("total_ms") = total_ms, cpp11::named_arg("mean_ms") = mean_ms,
+         cpp11::named_arg("max_ms") = max_ms});
+  }
+
+  // Timed calls in the Chrome trace event format, for chrome://tracing or Perfetto
+
+  static std::string chrome_trace() {
+    registry& reg = instance();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::vector<event> events;
+
+    for (auto& t : reg.threads) {
+      std::lock_guard<std::mutex> thread_lock(t->mutex);
+      events.insert(events.end(), t->events.begin(), t->events.end());
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](const event& a, const event& b) { return a.ts < b.ts; });
+
+    const unsigned long long n_events = reg.n_events.load(std::memory_order_relaxed);
+    const unsigned long long dropped = (n_events > CPP11ARMADILLO_TELEMETRY_MAX_EVENTS)
+                                           ? n_events - CPP11ARMADILLO_TELEMETRY_MAX_EVENTS
+                                           : 0;
+
+    std::ostringstream out;
+    out.precision(15);
+
+    out << "{\"traceEvents\":[";
+
+    for (size_t i = 0; i < events.size(); ++i) {
+      const event& e = events[i];
+
+      out << ((i > 0) ? ",\n" : "\n") << "{\"name\":\"" << e.name
+          << "\",\"cat\":\"armadillo\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.tid
+          << ",\"ts\":" << e.ts << ",\"dur\":" << e.dur << "}";
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":"
+        << dropped << "}}\n";
+
+    return out.str();
+  }
+
+  static bool write_chrome_trace(const std::string& path) {
+    std::ofstream f(path.c_str(), std::ios::binary);
+    f << chrome_trace();
+    return f.good();
+  }
+
+  // Clears the counters, the timings and the trace. Memory that is still in use keeps
+  // its size, so that releasing it later is accounted for.
+
+  static void reset() {
+    registry& reg = instance();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    reg.origin.store(clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    reg.n_events.store(0, std::memory_order_relaxed);
+
+    for (auto& t : reg.threads) {
+      std::lock_guard<std::mutex> thread_lock(t->mutex);
+      t->clear();
+      t->calls.clear();
+      t->events.clear();
+    }
+
+    total().clear();
+  }
+
+ private:
+  struct call_stats {
+    double calls = 0;
+    double total_us = 0;
+    double max_us = 0;
+  };
+
+  struct event {
+    const char* name;
+    int tid;
+    double ts;
+    double dur;
+  };
+
+  struct thread_stats {
+    int id = 0;
+    std::atomic<unsigned long long> acquires{0};
+    std::atomic<unsigned long long> releases{0};
+    std::atomic<unsigned long long> bytes_acquired{0};
+    std::atomic<unsigned long long> bytes_released{0};
+    std::atomic<long long> live{0};
+    std::atomic<long long> peak{0};
+
+    // timed calls of the thread, by the address of their name
+    std::mutex mutex;
+    std::unordered_map<const char*, call_stats> calls;
+    std::vector<event> events;
+
+    void update_peak(const long long n_bytes) {
+      const long long now = live.fetch_add(n_bytes, std::memory_order_relaxed) + n_bytes;
+      long long old = peak.load(std::memory_order_relaxed);
+
+      while (now > old && !peak.compare_exchange_weak(old, now, std::memory_order_relaxed)) {
+      }
+    }
+
+    void clear() {
+      acquires.store(0, std::memory_order_relaxed);
+      releases.store(0, std::memory_order_relaxed);
+      bytes_acquired.store(0, std::memory_order_relaxed);
+      bytes_released.store(0, std::memory_order_relaxed);
+      peak.store(live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+  };
+
+  // sizes of the blocks in use, one map per group of addresses
+  struct alignas(64) shard {
+    std::mutex mutex;
+    std::unordered_map<const void*, size_t> sizes;
+  };
+
+  // the mutex protects the list of threads, each record has its own
+  struct registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<thread_stats>> threads;
+    std::atomic<unsigned long long> n_events{0};
+    std::atomic<clock::rep> origin{clock::now().time_since_epoch().count()};
+    shard shards[CPP11ARMADILLO_TELEMETRY_SHARDS];
+  };
+
+  static registry& instance() {
+    static registry reg;
+    return reg;
+  }
+
+  static shard& shard_of(const void* mem) {
+    // blocks are at least 16 byte aligned, the low bits carry no information
+    const std::uintptr_t h = reinterpret_cast<std::uintptr_t>(mem) >> 4;
+    return instance().shards[(h ^ (h >> 12)) % CPP11ARMADILLO_TELEMETRY_SHARDS];
+  }
+
+  static thread_stats& total() {
+    static thread_stats t;
+    return t;
+  }
+
+  // the records of finished threads are kept, so that their counts stay in memory()
+
+  static thread_stats& local() {
+    static thread_local thread_stats* t = nullptr;
+
+    if (t == nullptr) {
+      registry& reg = instance();
+      std::lock_guard<std::mutex> lock(reg.mutex);
+
+      reg.threads.emplace_back(new thread_stats());
+      t = reg.threads.back().get();
+      t->id = static_cast<int>(reg.threads.size()) - 1;
+    }
+
+    return *t;
+  }
+};
+
+// Times the enclosing scope
+
+class TelemetryScope {
+ public:
+  explicit TelemetryScope(const char* name) : name_(name), start_(Telemetry::clock::now()) {}
+
+  ~TelemetryScope() { Telemetry::on_call(name_, start_, Telemetry::clock::now()); }
+
+ private:
+  const char* name_;
+  Telemetry::clock::time_point start_;
+};
+
+#define ARMA_TELEMETRY_ACQUIRE(mem, n_bytes) ::Telemetry::on_acquire((mem), (n_bytes))
+#define ARMA_TELEMETRY_RELEASE(mem) ::Telemetry::on_release((mem))
+#define ARMA_TELEMETRY_SCOPE(name) ::TelemetryScope arma_telemetry_scope_(name)
+
+#endif
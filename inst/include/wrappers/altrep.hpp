@@ -0,0 +1,253 @@
+#pragma once
+
+using namespace arma;
+using namespace cpp11;
+
+#ifndef ALTREP_HPP
+#define ALTREP_HPP
+
+// Note: the functions in this file return R vectors that keep pointing to the memory
+// of an Armadillo object (ALTREP), so that results can be passed to R without a
+// copy. The object is moved to the heap and freed by R's garbage collector.
+
+#include <Rversion.h>
+#include <cstdio>
+
+#if R_VERSION >= R_Version(3, 6, 0)
+
+// R_ext/Altrep.h uses 'class' as a parameter name in R < 4.0
+#define class klass
+extern "C" {
+#include <R_ext/Altrep.h>
+}
+#undef class
+
+template <typename T>
+class MatAltrep {
+ public:
+  // DLL and name of the package that uses cpp11armadillo, set by init_altrep()
+  static DllInfo*& dll() {
+    static DllInfo* dll = nullptr;
+    return dll;
+  }
+
+  static std::string& package() {
+    static std::string package;
+    return package;
+  }
+
+  static R_altrep_class_t get_class() {
+    static R_altrep_class_t klass = make_class(T());
+    return klass;
+  }
+
+  static SEXP make(Mat<T>&& x) {
+    if (dll() == nullptr) {
+      stop("The ALTREP classes are not registered, call init_altrep(dll) from a "
+           "[[cpp11::init]] function of the package");
+    }
+
+    // memory borrowed from an R vector is not protected by the new object
+    std::unique_ptr<Mat<T>> A(x.mem_state == 0 ? new Mat<T>(std::move(x))
+                                               : new Mat<T>(x));
+
+    sexp xp = safe[R_MakeExternalPtr](A.get(), R_NilValue, R_NilValue);
+    R_RegisterCFinalizerEx(xp, finalize, TRUE);
+    A.release();
+
+    return safe[R_new_altrep](get_class(), xp, R_NilValue);
+  }
+
+ private:
+  static Mat<T>* get(SEXP x) {
+    return static_cast<Mat<T>*>(R_ExternalPtrAddr(R_altrep_data1(x)));
+  }
+
+  static void finalize(SEXP xp) {
+    delete static_cast<Mat<T>*>(R_ExternalPtrAddr(xp));
+    R_ClearExternalPtr(xp);
+  }
+
+  static R_xlen_t length(SEXP x) { return static_cast<R_xlen_t>(get(x)->n_elem); }
+
+  static Rboolean inspect(SEXP x, int, int, int, void (*)(SEXP, int, int, int)) {
+    const Mat<T>* A = get(x);
+    Rprintf("cpp11armadillo Mat (%.0f x %.0f)\n", static_cast<double>(A->n_rows),
+            static_cast<double>(A->n_cols));
+    return TRUE;
+  }
+
+  static void* dataptr(SEXP x, Rboolean) { return get(x)->memptr(); }
+
+  static const void* dataptr_or_null(SEXP x) { return get(x)->memptr(); }
+
+  static T elt(SEXP x, R_xlen_t i) { return get(x)->mem[i]; }
+
+  static R_xlen_t get_region(SEXP x, R_xlen_t i, R_xlen_t n, T* buf) {
+    const Mat<T>* A = get(x);
+    const R_xlen_t len = static_cast<R_xlen_t>(A->n_elem);
+    const R_xlen_t ncopy = (len - i > n) ? n : len - i;
+
+    std::copy(A->mem + i, A->mem + i + ncopy, buf);
+
+    return ncopy;
+  }
+
+  static R_altrep_class_t make_class(double) {
+    const std::string name = package() + "_arma_mat_double";
+    R_altrep_class_t klass =
+        R_make_altreal_class(name.c_str(), package().c_str(), dll());
+    set_common_methods(klass);
+    R_set_altreal_Elt_method(klass, elt);
+    R_set_altreal_Get_region_method(klass, get_region);
+    return klass;
+  }
+
+  static R_altrep_class_t make_class(int) {
+    const std::string name = package() + "_arma_mat_int";
+    R_altrep_class_t klass =
+        R_make_altinteger_class(name.c_str(), package().c_str(), dll());
+    set_common_methods(klass);
+    R_set_altinteger_Elt_method(klass, elt);
+    R_set_altinteger_Get_region_method(klass, get_region);
+    return klass;
+  }
+
+  static void set_common_methods(R_altrep_class_t klass) {
+    R_set_altrep_Length_method(klass, length);
+    R_set_altrep_Inspect_method(klass, inspect);
+    R_set_altvec_Dataptr_method(klass, dataptr);
+    R_set_altvec_Dataptr_or_null_method(klass, dataptr_or_null);
+  }
+};
+
+// Registers the classes with the package DLL, it has to be called from a function
+// marked with [[cpp11::init]] before any of the functions below, e.g.
+//
+// [[cpp11::init]] void init_altrep_classes(DllInfo* dll) { init_altrep(dll, "mypkg"); }
+//
+// The classes are named after the package, so several packages can use them. This
+// runs while R loads the DLL, where an error cannot be raised: a failure gives a
+// warning and leaves the classes unregistered, the functions below then stop with an
+// error.
+
+inline void init_altrep(DllInfo* dll, const char* pkg) {
+  if (dll == nullptr || pkg == nullptr || pkg[0] == '\0') {
+    Rf_warning("init_altrep() needs the DllInfo* of the package and its name");
+    return;
+  }
+
+  MatAltrep<double>::dll() = dll;
+  MatAltrep<double>::package() = pkg;
+  MatAltrep<int>::dll() = dll;
+  MatAltrep<int>::package() = pkg;
+  MatAltrep<double>::get_class();
+  MatAltrep<int>::get_class();
+}
+
+// Name of the package that loaded a DLL, R names the DLL of a package after it
+
+inline std::string dll_package_name_(DllInfo* dll) {
+  list dlls(package("base")["getLoadedDLLs"]());
+
+  for (R_xlen_t i = 0; i < dlls.size(); ++i) {
+    list info(dlls[i]);
+
+    if (R_ExternalPtrAddr(info["info"]) == static_cast<void*>(dll)) {
+      return std::string(strings(info["name"])[0]);
+    }
+  }
+
+  stop("the DLL is not among the loaded ones");
+}
+
+// Same, with the package name looked up in getLoadedDLLs(), which evaluates R code
+// while the DLL is loaded
+
+inline void init_altrep(DllInfo* dll) {
+  char error[256] = "";
+
+  try {
+    init_altrep(dll, dll_package_name_(dll).c_str());
+  } catch (const std::exception& e) {
+    std::snprintf(error, sizeof(error), "%s", e.what());
+  } catch (...) {
+    std::snprintf(error, sizeof(error), "unknown error");
+  }
+
+  if (error[0] != '\0') {
+    Rf_warning("init_altrep() could not find the package name: %s", error);
+  }
+}
+
+template <typename T, typename U>
+inline U Mat_to_altrep_(Mat<T>&& x, const bool keep_dim) {
+  const int n = keep_dim ? as_dim_(x.n_rows) : 0;
+  const int m = keep_dim ? as_dim_(x.n_cols) : 0;
+
+  sexp y = MatAltrep<T>::make(std::move(x));
+
+  if (keep_dim) {
+    writable::integers dim({n, m});
+    Rf_setAttrib(y, R_DimSymbol, dim);
+  }
+
+  return U(y);
+}
+
+#else
+
+// R < 3.6, fall back to copying
+
+inline void init_altrep(DllInfo* dll, const char* pkg) {
+  (void)dll;
+  (void)pkg;
+}
+
+inline void init_altrep(DllInfo* dll) { (void)dll; }
+
+template <typename T, typename U>
+inline U Mat_to_altrep_(Mat<T>&& x, const bool keep_dim) {
+  const int n = keep_dim ? as_dim_(x.n_rows) : 0;
+  const int m = keep_dim ? as_dim_(x.n_cols) : 0;
+
+  using dblint = typename std::conditional<std::is_same<T, double>::value,
+                                           writable::doubles, writable::integers>::type;
+
+  dblint y(x.n_elem);
+  std::copy(x.memptr(), x.memptr() + x.n_elem, y.begin());
+
+  if (keep_dim) {
+    writable::integers dim({n, m});
+    Rf_setAttrib(y, R_DimSymbol, dim);
+  }
+
+  return U(y);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////
+// Armadillo to R
+////////////////////////////////////////////////////////////////
+
+// Pass the object with std::move() to avoid a copy, e.g.
+// return as_doubles_altrep(std::move(y));
+
+inline doubles as_doubles_altrep(Col<double> x) {
+  return Mat_to_altrep_<double, doubles>(std::move(x), false);
+}
+
+inline integers as_integers_altrep(Col<int> x) {
+  return Mat_to_altrep_<int, integers>(std::move(x), false);
+}
+
+inline doubles_matrix<> as_doubles_matrix_altrep(Mat<double> x) {
+  return Mat_to_altrep_<double, doubles_matrix<>>(std::move(x), true);
+}
+
+inline integers_matrix<> as_integers_matrix_altrep(Mat<int> x) {
+  return Mat_to_altrep_<int, integers_matrix<>>(std::move(x), true);
+}
+
+#endif
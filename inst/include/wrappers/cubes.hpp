@@ -0,0 +1,121 @@
+#pragma once
+
+using namespace arma;
+using namespace cpp11;
+
+#ifndef CUBES_HPP
+#define CUBES_HPP
+
+// Note: R arrays with three dimensions are column-major just like Cube, so the
+// conversion from R only needs to read the 'dim' attribute
+
+////////////////////////////////////////////////////////////////
+// R to Armadillo
+////////////////////////////////////////////////////////////////
+
+template <typename T>
+inline Cube<T> as_Cube(const T& x) {
+  // Generic implementation
+  throw std::runtime_error("Cannot convert to Cube");
+}
+
+template <typename T>
+inline Cube<T> as_Cube(const Cube<T>& x) {
+  return x;
+}
+
+template <typename T, typename U>
+inline Cube<T> dblint_array_to_Cube_(const U& x) {
+  SEXP dim = Rf_getAttrib(x.data(), R_DimSymbol);
+
+  if (Rf_length(dim) != 3) {
+    throw std::runtime_error("Cannot convert to Cube, the input is not a 3D array");
+  }
+
+  const uword n_rows = INTEGER(dim)[0];
+  const uword n_cols = INTEGER(dim)[1];
+  const uword n_slices = INTEGER(dim)[2];
+
+  // no copy, the Cube uses the memory of the R array
+  if (std::is_same<U, doubles>::value) {
+    return Cube<T>(reinterpret_cast<T*>(REAL(x.data())), n_rows, n_cols, n_slices,
+                   false, false);
+  } else {
+    return Cube<T>(reinterpret_cast<T*>(INTEGER(x.data())), n_rows, n_cols, n_slices,
+                   false, false);
+  }
+}
+
+inline Cube<double> as_Cube(const doubles& x) {
+  return dblint_array_to_Cube_<double, doubles>(x);
+}
+
+inline Cube<int> as_Cube(const integers& x) {
+  return dblint_array_to_Cube_<int, integers>(x);
+}
+
+// as_cube() = alias for as_Cube()
+
+template <typename T>
+inline Cube<T> as_cube(const T& x) {
+  return as_Cube(x);
+}
+
+inline Cube<double> as_cube(const doubles& x) { return as_Cube(x); }
+
+inline Cube<int> as_cube(const integers& x) { return as_Cube(x); }
+
+////////////////////////////////////////////////////////////////
+// Armadillo to R
+////////////////////////////////////////////////////////////////
+
+// Double/Integer to array
+
+template <typename T, typename U>
+inline U Cube_to_dblint_array_(const Cube<T>& x) {
+  const int n_rows = as_dim_(x.n_rows);
+  const int n_cols = as_dim_(x.n_cols);
+  const int n_slices = as_dim_(x.n_slices);
+
+  writable::integers dim({n_rows, n_cols, n_slices});
+
+  sexp y = alloc_vector_(std::is_same<U, doubles>::value ? REALSXP : INTSXP, x.n_elem);
+
+  if (std::is_same<U, doubles>::value) {
+    std::memcpy(REAL(y), x.memptr(), x.n_elem * sizeof(double));
+  } else {
+    std::memcpy(INTEGER(y), x.memptr(), x.n_elem * sizeof(int));
+  }
+
+  Rf_setAttrib(y, R_DimSymbol, dim);
+
+  return U(y);
+}
+
+inline doubles as_doubles_array(const Cube<double>& x) {
+  return Cube_to_dblint_array_<double, doubles>(x);
+}
+
+#if defined(CPP11ARMADILLO_USE_R_ALLOC)
+// A temporary that already lives inside an R vector is handed over instead of copied,
+// and left empty (see as_doubles_matrix(Mat<double>&&))
+
+inline doubles as_doubles_array(Cube<double>&& x) {
+  writable::integers dim({as_dim_(x.n_rows), as_dim_(x.n_cols), as_dim_(x.n_slices)});
+
+  sexp owner = RAllocator::take(x);
+
+  if (owner == R_NilValue) {
+    return Cube_to_dblint_array_<double, doubles>(x);
+  }
+
+  Rf_setAttrib(owner, R_DimSymbol, dim);
+  return doubles(owner);
+}
+#endif
+
+inline integers as_integers_array(const Cube<int>& x) {
+  return Cube_to_dblint_array_<int, integers>(x);
+}
+
+#endif
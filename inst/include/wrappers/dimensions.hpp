@@ -0,0 +1,85 @@
+#pragma once
+
+using namespace arma;
+using namespace cpp11;
+
+#ifndef DIMENSIONS_HPP
+#define DIMENSIONS_HPP
+
+// Note: R vectors have R_xlen_t lengths (long vectors can hold more than 2^31 - 1
+// elements), but each dimension of an R matrix or array is an int. Armadillo sizes
+// are uword, which is 64-bit unless ARMA_32BIT_WORD is defined.
+
+////////////////////////////////////////////////////////////////
+// R to Armadillo
+////////////////////////////////////////////////////////////////
+
+inline uword as_uword_(const R_xlen_t n) {
+  if (static_cast<unsigned long long>(n) >
+      static_cast<unsigned long long>(std::numeric_limits<uword>::max())) {
+    stop("Cannot convert a vector of length %.0f, uword is too small (see ARMA_64BIT_WORD)",
+         static_cast<double>(n));
+  }
+
+  return static_cast<uword>(n);
+}
+
+////////////////////////////////////////////////////////////////
+// Armadillo to R
+////////////////////////////////////////////////////////////////
+
+inline int as_dim_(const uword n) {
+  if (n > static_cast<uword>(std::numeric_limits<int>::max())) {
+    stop("Cannot convert to R, the dimension %.0f is larger than the largest R integer",
+         static_cast<double>(n));
+  }
+
+  return static_cast<int>(n);
+}
+
+inline R_xlen_t as_xlen_(const uword n) {
+  if (static_cast<unsigned long long>(n) > static_cast<unsigned long long>(R_XLEN_T_MAX)) {
+    stop("Cannot convert to R, the length %.0f is larger than the longest R vector",
+         static_cast<double>(n));
+  }
+
+  return static_cast<R_xlen_t>(n);
+}
+
+// Rf_allocMatrix() computes the length as R_xlen_t, so matrices with more than 2^31 - 1
+// elements do not overflow
+
+inline SEXP alloc_matrix_(const SEXPTYPE type, const uword n, const uword m) {
+  return safe[Rf_allocMatrix](type, as_dim_(n), as_dim_(m));
+}
+
+inline SEXP alloc_vector_(const SEXPTYPE type, const uword n) {
+  return safe[Rf_allocVector](type, as_xlen_(n));
+}
+
+// Integers outside of the int range (or equal to NA_INTEGER) become NA, as in
+// as.integer()
+
+template <typename T>
+inline bool fits_int_(const T v) {
+  if (std::is_signed<T>::value) {
+    return static_cast<long long>(v) > std::numeric_limits<int>::min() &&
+           static_cast<long long>(v) <= std::numeric_limits<int>::max();
+  }
+
+  return static_cast<unsigned long long>(v) <=
+         static_cast<unsigned long long>(std::numeric_limits<int>::max());
+}
+
+template <typename T>
+inline void int_copy_(const T* src, int* dst, const uword n) {
+  const int na = NA_INTEGER;
+
+#pragma omp parallel for simd schedule(static) if (n > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword i = 0; i < n; ++i) {
+    dst[i] = fits_int_(src[i]) ? static_cast<int>(src[i]) : na;
+  }
+}
+
+#endif
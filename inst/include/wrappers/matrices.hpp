@@ -35,7 +35,7 @@ inline Mat<T> dblint_matrix_to_Mat_(const U& x) {
 
 template <typename T, typename U>
 inline Mat<T> dblint_to_Mat_(const U& x) {
-  const int n = x.size();
+  const uword n = as_uword_(x.size());
 
   if (std::is_same<U, doubles>::value) {
     return Mat<T>(reinterpret_cast<T*>(REAL(x.data())), n, 1, false, false);
@@ -56,26 +56,30 @@ inline Mat<double> as_Mat(const doubles& x) { return dblint_to_Mat_<double, doub
 
 inline Mat<int> as_Mat(const integers& x) { return dblint_to_Mat_<int, integers>(x); }
 
+// Element type conversion (e.g., double to float) in one flat loop, vectorised and
+// parallel for large inputs
+
+template <typename T, typename S>
+inline void cast_copy_(const S* src, T* dst, const uword n) {
+#pragma omp parallel for simd schedule(static) if (n > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword idx = 0; idx < n; ++idx) {
+    dst[idx] = static_cast<T>(src[idx]);
+  }
+}
+
 // Convert integers_matrix<> to umat/imat
 
 template <typename TargetMatType>
 inline TargetMatType as_target_mat(const integers_matrix<>& x) {
   const uword n = x.nrow();
   const uword m = x.ncol();
-  const uword nm = n * m;
 
   // Allocate our Armadillo matrix once
-  TargetMatType y(n, m);
-
-  // Raw pointers into R's data and Armadillo's storage
-  const int* src = INTEGER(x.data());
-  typename TargetMatType::elem_type* dst = y.memptr();
+  TargetMatType y(n, m, arma::fill::none);
 
-// Copy all entries in one flat loop (faster than y(i,j) indexing)
-#pragma omp parallel for if (nm > 10000)
-  for (uword idx = 0; idx < nm; ++idx) {
-    dst[idx] = static_cast<typename TargetMatType::elem_type>(src[idx]);
-  }
+  // Copy all entries in one flat loop (faster than y(i,j) indexing)
+  cast_copy_(INTEGER(x.data()), y.memptr(), y.n_elem);
 
   return y;
 }
@@ -84,9 +88,116 @@ inline umat as_umat(const integers_matrix<>& x) { return as_target_mat<umat>(x);
 
 inline imat as_imat(const integers_matrix<>& x) { return as_target_mat<imat>(x); }
 
+// Narrow doubles_matrix<> to fmat directly from R's memory
+
 inline fmat as_fmat(const doubles_matrix<>& x) {
-  Mat<double> y = dblint_matrix_to_Mat_<double, doubles_matrix<>>(x);
-  return arma::conv_to<fmat>::from(y);
+  fmat y(x.nrow(), x.ncol(), arma::fill::none);
+  cast_copy_(REAL(x.data()), y.memptr(), y.n_elem);
+  return y;
+}
+
+// data.frame of double, integer or logical columns to Mat, one column per thread
+// (no as.matrix() copy in R). NA integers and logicals become NaN. cols holds the R
+// (1-based) numbers of the columns to convert, or all of them if it is empty.
+
+template <typename T>
+inline Mat<T> data_frame_to_Mat_(const data_frame& x, const integers& cols) {
+  const uword n = x.nrow();
+  const uword m = cols.empty() ? static_cast<uword>(x.size()) : cols.size();
+
+  // R API calls and errors stay on the main thread
+  std::vector<SEXP> src(m);
+
+  for (uword j = 0; j < m; ++j) {
+    const int col = cols.empty() ? static_cast<int>(j) + 1 : cols[j];
+
+    if (col == NA_INTEGER || col < 1 || col > x.size()) {
+      stop("Invalid column number %d", col);
+    }
+
+    src[j] = VECTOR_ELT(x.data(), col - 1);
+
+    const int type = TYPEOF(src[j]);
+
+    if ((type != REALSXP && type != INTSXP && type != LGLSXP) || Rf_isFactor(src[j])) {
+      stop("Cannot convert column %d to Mat, it is not numeric", col);
+    }
+  }
+
+  std::vector<const double*> dbl(m, nullptr);
+  std::vector<const int*> ints(m, nullptr);
+
+  for (uword j = 0; j < m; ++j) {
+    if (TYPEOF(src[j]) == REALSXP) {
+      dbl[j] = REAL(src[j]);
+    } else {
+      ints[j] = (TYPEOF(src[j]) == INTSXP) ? INTEGER(src[j]) : LOGICAL(src[j]);
+    }
+  }
+
+  Mat<T> y(n, m, arma::fill::none);
+
+#pragma omp parallel for schedule(static) if (n * m > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword j = 0; j < m; ++j) {
+    T* dst = y.colptr(j);
+
+    if (dbl[j] != nullptr) {
+      const double* col = dbl[j];
+
+#pragma omp simd
+      for (uword i = 0; i < n; ++i) {
+        dst[i] = static_cast<T>(col[i]);
+      }
+    } else {
+      const int* col = ints[j];
+
+#pragma omp simd
+      for (uword i = 0; i < n; ++i) {
+        dst[i] = (col[i] == NA_INTEGER) ? std::numeric_limits<T>::quiet_NaN()
+                                        : static_cast<T>(col[i]);
+      }
+    }
+  }
+
+  return y;
+}
+
+inline Mat<double> as_Mat(const data_frame& x) {
+  return data_frame_to_Mat_<double>(x, integers());
+}
+
+inline Mat<double> as_Mat(const data_frame& x, const integers& cols) {
+  return data_frame_to_Mat_<double>(x, cols);
+}
+
+inline fmat as_fmat(const data_frame& x) { return data_frame_to_Mat_<float>(x, integers()); }
+
+inline fmat as_fmat(const data_frame& x, const integers& cols) {
+  return data_frame_to_Mat_<float>(x, cols);
+}
+
+// Complex matrices (CPLXSXP), no copy as Rcomplex and std::complex<double> share the
+// same layout
+
+static_assert(sizeof(Rcomplex) == sizeof(std::complex<double>),
+              "Rcomplex and std::complex<double> must have the same size");
+
+inline Mat<std::complex<double>> as_cx_mat(SEXP x) {
+  if (TYPEOF(x) != CPLXSXP) {
+    stop("Input is not a complex vector or matrix");
+  }
+
+  uword n = as_uword_(Rf_xlength(x));
+  uword m = 1;
+
+  if (Rf_isMatrix(x)) {
+    n = Rf_nrows(x);
+    m = Rf_ncols(x);
+  }
+
+  return Mat<std::complex<double>>(reinterpret_cast<std::complex<double>*>(COMPLEX(x)),
+                                   n, m, false, false);
 }
 
 // cpp11armadillo 0.4.3
@@ -110,6 +221,8 @@ inline Mat<double> as_mat(const doubles& x) { return as_Mat(x); }
 
 inline Mat<int> as_mat(const integers& x) { return as_Mat(x); }
 
+inline Mat<double> as_mat(const data_frame& x) { return as_Mat(x); }
+
 ////////////////////////////////////////////////////////////////
 // Armadillo to R
 ////////////////////////////////////////////////////////////////
@@ -118,71 +231,62 @@ inline Mat<int> as_mat(const integers& x) { return as_Mat(x); }
 
 template <typename T, typename U>
 inline U Mat_to_dblint_matrix_(const Mat<T>& A) {
-  const int n = A.n_rows;
-  const int m = A.n_cols;
-
-  using dblint_matrix =
-      typename std::conditional<std::is_same<U, doubles_matrix<>>::value,
-                                writable::doubles_matrix<>,
-                                writable::integers_matrix<>>::type;
-
-  dblint_matrix B(n, m);
+  const int n = as_dim_(A.n_rows);
+  const int m = as_dim_(A.n_cols);
 
   if (std::is_same<U, doubles_matrix<>>::value) {
-    double* B_data = REAL(B);
-    std::memcpy(B_data, A.memptr(), n * m * sizeof(double));
+    sexp B = alloc_matrix_(REALSXP, n, m);
+    std::memcpy(REAL(B), A.memptr(), A.n_elem * sizeof(double));
+    return U(B);
   } else {
-    int* B_data = INTEGER(B);
-    std::memcpy(B_data, A.memptr(), n * m * sizeof(int));
+    sexp B = alloc_matrix_(INTSXP, n, m);
+    std::memcpy(INTEGER(B), A.memptr(), A.n_elem * sizeof(int));
+    return U(B);
   }
-
-  return B;
 }
 
 inline doubles_matrix<> as_doubles_matrix(const Mat<double>& A) {
   return Mat_to_dblint_matrix_<double, doubles_matrix<>>(A);
 }
 
+#if defined(CPP11ARMADILLO_USE_R_ALLOC)
+// A temporary that already lives inside an R vector is handed over instead of copied,
+// and left empty. Named objects are copied, as they can still be used afterwards,
+// std::move() hands them over too.
+
+inline doubles_matrix<> as_doubles_matrix(Mat<double>&& A) {
+  const int n = as_dim_(A.n_rows);
+  const int m = as_dim_(A.n_cols);
+
+  sexp owner = RAllocator::take(A);
+
+  if (owner == R_NilValue) {
+    return Mat_to_dblint_matrix_<double, doubles_matrix<>>(A);
+  }
+
+  writable::integers dim({n, m});
+  Rf_setAttrib(owner, R_DimSymbol, dim);
+  return doubles_matrix<>(owner);
+}
+#endif
+
 inline integers_matrix<> as_integers_matrix(const Mat<int>& A) {
   // Fast path: int to int
   return Mat_to_dblint_matrix_<int, integers_matrix<>>(A);
 }
 
-inline integers_matrix<> as_integers_matrix(const Mat<long long>& A) {
-  // Explicit cast for long long to int
-  const int n = A.n_rows;
-  const int m = A.n_cols;
-  writable::integers_matrix<> B(n, m);
-  int* B_data = INTEGER(B);
-  const long long* A_data = A.memptr();
-  for (int i = 0; i < n * m; ++i) {
-    B_data[i] = static_cast<int>(A_data[i]);
-  }
-  return B;
-}
-
-// Convert umat/imat to integers_matrix<>
+// Convert umat/imat to integers_matrix<>, values outside of the int range become NA
+// (uword and sword are 64-bit by default, a plain memcpy() would mix up the values)
 
 template <typename T>
 inline integers_matrix<> as_integers_matrix_template(const Mat<T>& A) {
-  const size_t n = A.n_rows;
-  const size_t m = A.n_cols;
-  const size_t nm = n * m;
-
-  writable::integers_matrix<> B(n, m);
-  int* B_data = INTEGER(B);
-
-  // Convert element by element to handle different types
-  //   const T* A_data = A.memptr();
-
-  // #pragma omp parallel for if (nm > 10000)
-  //   for (size_t idx = 0; idx < nm; ++idx) {
-  //     B_data[idx] = static_cast<int>(A_data[idx]);
-  //   }
-
-  std::memcpy(B_data, A.memptr(), nm * sizeof(int));
+  sexp B = alloc_matrix_(INTSXP, A.n_rows, A.n_cols);
+  int_copy_(A.memptr(), INTEGER(B), A.n_elem);
+  return integers_matrix<>(B);
+}
 
-  return B;
+inline integers_matrix<> as_integers_matrix(const Mat<long long>& A) {
+  return as_integers_matrix_template(A);
 }
 
 inline integers_matrix<> as_integers_matrix(const umat& A) {
@@ -193,12 +297,22 @@ inline integers_matrix<> as_integers_matrix(const umat& A) {
 
 template <typename T>
 inline list Mat_to_complex_matrix_(const Mat<T>& A) {
-  Mat<double> A_real = real(A);
-  Mat<double> A_imag = imag(A);
+  sexp A_real = alloc_matrix_(REALSXP, A.n_rows, A.n_cols);
+  sexp A_imag = alloc_matrix_(REALSXP, A.n_rows, A.n_cols);
+
+  double* real_data = REAL(A_real);
+  double* imag_data = REAL(A_imag);
+  const T* A_data = A.memptr();
+
+  // split the real and imaginary parts in a single pass
+  for (uword i = 0; i < A.n_elem; ++i) {
+    real_data[i] = std::real(A_data[i]);
+    imag_data[i] = std::imag(A_data[i]);
+  }
 
   writable::list B;
-  B.push_back({"real"_nm = as_doubles_matrix(A_real)});
-  B.push_back({"imag"_nm = as_doubles_matrix(A_imag)});
+  B.push_back({"real"_nm = A_real});
+  B.push_back({"imag"_nm = A_imag});
 
   return B;
 }
@@ -207,50 +321,33 @@ inline list as_complex_matrix(const Mat<std::complex<double>>& A) {
   return Mat_to_complex_matrix_<std::complex<double>>(A);
 }
 
-// Specialized version for sparse matrices
+// Complex to a native R complex matrix (CPLXSXP)
 
 template <typename T>
-inline integers_matrix<> as_integers_matrix(const SpMat<T>& A) {
-  const uword n = A.n_rows;
-  const uword m = A.n_cols;
-  const size_t nm = n * m;
-
-  writable::integers_matrix<> B(n, m);
-  int* B_data = INTEGER(B);
-
-  // Initialize with zeros
-  std::memset(B_data, 0, nm * sizeof(int));
-
-  // Copy non-zero elements
-  // for (typename SpMat<T>::const_iterator it = A.begin(); it != A.end(); ++it) {
-  //   B(it.row(), it.col()) = static_cast<int>(*it);
-  // }
-
-  const auto& col_ptrs = A.col_ptrs;     // length m+1
-  const auto& row_inds = A.row_indices;  // length nnz
-  const auto& values = A.values;         // length nnz
-
-  uword i, j, start, end, idx;
-
-  for (j = 0; j < m; ++j) {
-    start = col_ptrs[j];
-    end = col_ptrs[j + 1];
-    for (idx = start; idx < end; ++idx) {
-      i = row_inds[idx];
-      // linear index = row + col * n
-      B_data[i + j * n] = static_cast<int>(values[idx]);
+inline SEXP Mat_to_complexes_matrix_(const Mat<T>& A) {
+  sexp B = alloc_matrix_(CPLXSXP, A.n_rows, A.n_cols);
+
+  Rcomplex* B_data = COMPLEX(B);
+  const T* A_data = A.memptr();
+
+  if (std::is_same<T, std::complex<double>>::value) {
+    std::memcpy(B_data, A_data, A.n_elem * sizeof(Rcomplex));
+  } else {
+    for (uword i = 0; i < A.n_elem; ++i) {
+      B_data[i].r = std::real(A_data[i]);
+      B_data[i].i = std::imag(A_data[i]);
     }
   }
 
   return B;
 }
 
-inline integers_matrix<> as_integers_matrix(const SpMat<unsigned long long>& A) {
-  return as_integers_matrix<unsigned long long>(A);
+inline SEXP as_complexes_matrix(const Mat<std::complex<double>>& A) {
+  return Mat_to_complexes_matrix_<std::complex<double>>(A);
 }
 
-inline integers_matrix<> as_integers_matrix(const SpMat<long long>& A) {
-  return as_integers_matrix<long long>(A);
+inline SEXP as_complexes_matrix(const Mat<std::complex<float>>& A) {
+  return Mat_to_complexes_matrix_<std::complex<float>>(A);
 }
 
 #endif
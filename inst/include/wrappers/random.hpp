@@ -0,0 +1,570 @@
+#pragma once
+
+using namespace arma;
+using namespace cpp11;
+
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+// Note: R's RNG can only be used from the main thread and costs one call per value.
+// The fills below draw a 64-bit key from R's RNG once, and then generate the values
+// in parallel from a counter-based generator (Philox4x32-10, Salmon et al. 2011),
+// where value i only depends on the key and on i. The results are the same for a
+// given set.seed(), regardless of the number of threads.
+
+class RRngBlock {
+ public:
+  typedef std::uint32_t word;
+
+  struct key_type {
+    word k0;
+    word k1;
+  };
+
+  // Main thread only, the caller is responsible for GetRNGstate()/PutRNGstate()
+
+  static key_type draw_key() {
+    key_type key;
+    key.k0 = draw_word();
+    key.k1 = draw_word();
+    return key;
+  }
+
+  // Four random words for the block number `ctr`
+
+  static void philox(const key_type& key, const std::uint64_t ctr, word* out) {
+    word c0 = static_cast<word>(ctr);
+    word c1 = static_cast<word>(ctr >> 32);
+    word c2 = 0;
+    word c3 = 0;
+    word k0 = key.k0;
+    word k1 = key.k1;
+
+    for (int r = 0; r < 10; ++r) {
+      if (r > 0) {
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+      }
+
+      const std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53u) * c0;
+      const std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * c2;
+
+      const word n0 = static_cast<word>(p1 >> 32) ^ c1 ^ k0;
+      const word n2 = static_cast<word>(p0 >> 32) ^ c3 ^ k1;
+
+      c1 = static_cast<word>(p1);
+      c3 = static_cast<word>(p0);
+      c0 = n0;
+      c2 = n2;
+    }
+
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+  }
+
+  // Uniform double in (0,1) with 53 random bits, as runif() it never returns 0 or 1
+
+  static double to_unif(const word hi, const word lo) {
+    const std::uint64_t x = (static_cast<std::uint64_t>(hi) << 32) | lo;
+    return (static_cast<double>(x >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+  }
+
+  // Values are generated in chunks, so that each thread works on its own part of the
+  // output and the transformations run over contiguous buffers
+
+  static constexpr uword chunk_size = 1024;
+
+  // Uniform values in (a, a + r)
+
+  template <typename eT>
+  static void fill_randu(eT* mem, const uword N, const double a, const double r) {
+    if (N == 0) {
+      return;
+    }
+
+    const key_type key = draw_key();
+    const uword n_chunks = (N + chunk_size - 1) / chunk_size;
+
+#pragma omp parallel for schedule(static) if (N > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword c = 0; c < n_chunks; ++c) {
+      double u[chunk_size];
+      uniforms(key, c, u);
+
+      const uword start = c * chunk_size;
+      const uword len = std::min(chunk_size, N - start);
+      eT* out = mem + start;
+
+#pragma omp simd
+      for (uword i = 0; i < len; ++i) {
+        out[i] = eT(u[i] * r + a);
+      }
+    }
+  }
+
+  // Normal values with Box-Muller, each pair of uniforms gives a pair of normals
+
+  template <typename eT>
+  static void fill_randn(eT* mem, const uword N, const double mu, const double sd) {
+    if (N == 0) {
+      return;
+    }
+
+    const key_type key = draw_key();
+    const uword n_chunks = (N + chunk_size - 1) / chunk_size;
+    const double two_pi = 6.283185307179586476925286766559;
+
+#pragma omp parallel for schedule(static) if (N > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword c = 0; c < n_chunks; ++c) {
+      double u[chunk_size];
+      double z[chunk_size];
+      uniforms(key, c, u);
+
+#pragma omp simd
+      for (uword i = 0; i < chunk_size / 2; ++i) {
+        const double rad = std::sqrt(-2.0 * std::log(u[2 * i]));
+        const double theta = two_pi * u[2 * i + 1];
+        z[2 * i] = rad * std::cos(theta);
+        z[2 * i + 1] = rad * std::sin(theta);
+      }
+
+      const uword start = c * chunk_size;
+      const uword len = std::min(chunk_size, N - start);
+      eT* out = mem + start;
+
+#pragma omp simd
+      for (uword i = 0; i < len; ++i) {
+        out[i] = eT(z[i] * sd + mu);
+      }
+    }
+  }
+
+  // Integers in [a, b] without modulo bias. As R_unif_index(), the values are the
+  // lowest bits of a random word and are rejected when they are outside of the range.
+  // Value i uses the four words of block i, and a stream of its own in the rare case
+  // that all of them are rejected.
+
+  template <typename eT>
+  static void fill_randi(eT* mem, const uword N, const int a, const int b) {
+    if (N == 0) {
+      return;
+    }
+
+    const key_type key = draw_key();
+    const key_type key_retry = derive(key, 1);
+    const std::uint64_t n = static_cast<std::uint64_t>(static_cast<long long>(b) - a + 1);
+    const std::uint64_t mask = bit_mask(n - 1);
+
+#pragma omp parallel for schedule(static) if (N > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword i = 0; i < N; ++i) {
+      word w[4];
+      philox(key, i, w);
+
+      std::uint64_t v = n;
+
+      for (int k = 0; k < 4 && v >= n; ++k) {
+        v = w[k] & mask;
+      }
+
+      if (v >= n) {
+        stream s(key_retry, static_cast<std::uint64_t>(i) << 16);
+        v = s.index(n);
+      }
+
+      mem[i] = eT(static_cast<long long>(a) + static_cast<long long>(v));
+    }
+  }
+
+  // Random permutation in place. Small inputs use Fisher-Yates, larger ones are split
+  // in blocks that are shuffled in parallel and then merged pairwise (MergeShuffle,
+  // Bacher et al. 2015), with the merges of each level also running in parallel.
+
+  static constexpr uword shuffle_block = 65536;
+
+  template <typename eT>
+  static void shuffle(eT* mem, const uword N) {
+    if (N < 2) {
+      return;
+    }
+
+    const key_type key = draw_key();
+    const uword n_blocks = (N + shuffle_block - 1) / shuffle_block;
+
+#pragma omp parallel for schedule(static) if (n_blocks > 1) \
+    num_threads(Parallel::max_threads())
+    for (uword k = 0; k < n_blocks; ++k) {
+      const uword start = k * shuffle_block;
+      const uword len = std::min(shuffle_block, N - start);
+
+      stream s(key, static_cast<std::uint64_t>(k) << 40);
+      eT* t = mem + start;
+
+      for (uword i = len - 1; i > 0; --i) {
+        std::swap(t[i], t[s.index(i + 1)]);
+      }
+    }
+
+    std::uint64_t level = 2;
+
+    for (uword width = shuffle_block; width < N; width *= 2, ++level) {
+      const uword n_pairs = (N + 2 * width - 1) / (2 * width);
+      const key_type level_key = derive(key, level);
+
+#pragma omp parallel for schedule(dynamic) if (n_pairs > 1) \
+    num_threads(Parallel::max_threads())
+      for (uword p = 0; p < n_pairs; ++p) {
+        const uword start = p * 2 * width;
+        const uword mid = std::min(start + width, N);
+        const uword end = std::min(start + 2 * width, N);
+
+        if (mid < end) {
+          stream s(level_key, static_cast<std::uint64_t>(p) << 40);
+          merge(mem + start, mid - start, end - start, s);
+        }
+      }
+    }
+  }
+
+  // Gamma values with shape a and scale b (Marsaglia and Tsang 2000). The number of
+  // rejections varies, so each value has its own stream and the result does not depend
+  // on how the values are split between threads.
+
+  template <typename eT>
+  static void fill_randg(eT* mem, const uword N, const double a, const double b) {
+    if (N == 0) {
+      return;
+    }
+
+    const key_type key = draw_key();
+
+#pragma omp parallel for schedule(static) if (N > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword i = 0; i < N; ++i) {
+      stream s(key, static_cast<std::uint64_t>(i) << 16);
+      mem[i] = eT(gamma_draw(s, a) * b);
+    }
+  }
+
+  // chunk_size uniforms of the chunk number `c`, two per Philox block
+
+  static void uniforms(const key_type& key, const uword c, double* u) {
+    const std::uint64_t first = static_cast<std::uint64_t>(c) * (chunk_size / 2);
+
+    for (uword b = 0; b < chunk_size / 2; ++b) {
+      word w[4];
+      philox(key, first + b, w);
+      u[2 * b] = to_unif(w[0], w[1]);
+      u[2 * b + 1] = to_unif(w[2], w[3]);
+    }
+  }
+
+ private:
+  // Sequential words from consecutive blocks, starting at block `first`
+
+  class stream {
+   public:
+    stream(const key_type& key, const std::uint64_t first)
+        : key_(key),
+          ctr_(first),
+          pos_(4),
+          bits_(0),
+          n_bits_(0),
+          spare_(0),
+          has_spare_(false) {}
+
+    word next() {
+      if (pos_ == 4) {
+        philox(key_, ctr_++, buf_);
+        pos_ = 0;
+      }
+
+      return buf_[pos_++];
+    }
+
+    bool bit() {
+      if (n_bits_ == 0) {
+        bits_ = next();
+        n_bits_ = 32;
+      }
+
+      const bool out = (bits_ & 1u) != 0;
+      bits_ >>= 1;
+      --n_bits_;
+
+      return out;
+    }
+
+    double unif() {
+      const word hi = next();
+      const word lo = next();
+      return to_unif(hi, lo);
+    }
+
+    // Box-Muller, the second value of each pair is kept for the next call
+
+    double norm() {
+      if (has_spare_) {
+        has_spare_ = false;
+        return spare_;
+      }
+
+      const double rad = std::sqrt(-2.0 * std::log(unif()));
+      const double theta = 6.283185307179586476925286766559 * unif();
+
+      spare_ = rad * std::sin(theta);
+      has_spare_ = true;
+
+      return rad * std::cos(theta);
+    }
+
+    // uniform in [0, n)
+
+    std::uint64_t index(const std::uint64_t n) {
+      if (n < 2) {
+        return 0;
+      }
+
+      const std::uint64_t mask = bit_mask(n - 1);
+      std::uint64_t v;
+
+      do {
+        v = next();
+
+        if (mask > 0xFFFFFFFFu) {
+          v = (v << 32) | next();
+        }
+
+        v &= mask;
+      } while (v >= n);
+
+      return v;
+    }
+
+   private:
+    key_type key_;
+    std::uint64_t ctr_;
+    word buf_[4];
+    int pos_;
+    word bits_;
+    int n_bits_;
+    double spare_;
+    bool has_spare_;
+  };
+
+  static double gamma_draw(stream& s, const double a) {
+    // shape below one: G(a) = G(a + 1) * U^(1 / a)
+    if (a < 1.0) {
+      return gamma_draw(s, a + 1.0) * std::pow(s.unif(), 1.0 / a);
+    }
+
+    const double d = a - 1.0 / 3.0;
+    const double c = 1.0 / std::sqrt(9.0 * d);
+
+    while (true) {
+      const double x = s.norm();
+      double v = 1.0 + c * x;
+
+      if (v <= 0.0) {
+        continue;
+      }
+
+      v = v * v * v;
+
+      const double u = s.unif();
+      const double x2 = x * x;
+
+      if (u < 1.0 - 0.0331 * x2 * x2 ||
+          std::log(u) < 0.5 * x2 + d * (1.0 - v + std::log(v))) {
+        return d * v;
+      }
+    }
+  }
+
+  // smallest 2^k - 1 that is greater or equal to x
+
+  static std::uint64_t bit_mask(std::uint64_t x) {
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    x |= x >> 32;
+    return x;
+  }
+
+  // independent key for each use of the generator within a single fill
+
+  static key_type derive(const key_type& key, const std::uint64_t tag) {
+    key_type out;
+    out.k0 = key.k0 ^ static_cast<word>(0x9E3779B9u * tag);
+    out.k1 = key.k1 ^ static_cast<word>(0x85EBCA6Bu * tag);
+    return out;
+  }
+
+  // merges two shuffled runs t[0, m) and t[m, n) into a shuffled t[0, n)
+
+  template <typename eT>
+  static void merge(eT* t, const uword m, const uword n, stream& s) {
+    uword u = 0;
+    uword v = m;
+
+    while (true) {
+      if (s.bit()) {
+        if (v == n) {
+          break;
+        }
+        std::swap(t[u], t[v++]);
+      } else if (u == v) {
+        break;
+      }
+      ++u;
+    }
+
+    for (; u < n; ++u) {
+      std::swap(t[u], t[s.index(u + 1)]);
+    }
+  }
+
+  static word draw_word() {
+    // unif_rand() has 32 bits of resolution for the default generator
+    return static_cast<word>(std::floor(::unif_rand() * 4294967296.0));
+  }
+};
+
+// Multivariate normal draws with a fixed mean and covariance. The Cholesky factor is
+// computed once, and each call fills a block of standard normals and transforms all of
+// the draws with a single matrix product.
+
+template <typename eT>
+class MvnGenerator {
+ public:
+  MvnGenerator(const Col<eT>& mu, const Mat<eT>& sigma) : mu_(mu) {
+    if (sigma.n_rows != sigma.n_cols || sigma.n_rows != mu.n_elem) {
+      stop("MvnGenerator: the covariance matrix must be square and match the mean");
+    }
+
+    if (!chol(L_, sigma, "lower")) {
+      stop("MvnGenerator: the covariance matrix is not symmetric positive definite");
+    }
+  }
+
+  // One draw per column, main thread only (the seed comes from R's RNG)
+
+  Mat<eT> draw(const uword n) const {
+    Mat<eT> Z(mu_.n_elem, n, fill::none);
+    RRngBlock::fill_randn(Z.memptr(), Z.n_elem, 0.0, 1.0);
+
+    Mat<eT> X = trimatl(L_) * Z;
+    X.each_col() += mu_;
+
+    return X;
+  }
+
+  const Mat<eT>& factor() const { return L_; }
+
+ private:
+  Col<eT> mu_;
+  Mat<eT> L_;
+};
+
+// Wishart draws with a fixed scale matrix S and degrees of freedom df, with the
+// Bartlett decomposition W = L A A' L', where S = L L' and A is lower triangular with
+// sqrt(chi2(df - i)) on the diagonal and standard normals below it. The draws are
+// computed in parallel.
+
+template <typename eT>
+class WishartGenerator {
+ public:
+  WishartGenerator(const Mat<eT>& S, const double df) : df_(df) {
+    if (S.n_rows != S.n_cols) {
+      stop("WishartGenerator: the scale matrix must be square");
+    }
+
+    if (!(df > static_cast<double>(S.n_rows) - 1.0)) {
+      stop("WishartGenerator: df must be greater than the number of rows minus one");
+    }
+
+    if (!chol(L_, S, "lower")) {
+      stop("WishartGenerator: the scale matrix is not symmetric positive definite");
+    }
+  }
+
+  // One draw per slice, main thread only
+
+  Cube<eT> draw(const uword n) const {
+    const uword d = L_.n_rows;
+    const uword n_off = d * (d - 1) / 2;
+
+    Mat<eT> Z(n_off, n, fill::none);
+    RRngBlock::fill_randn(Z.memptr(), Z.n_elem, 0.0, 1.0);
+
+    // column i holds the chi2(df - i) values of all the draws
+    Mat<eT> C(n, d, fill::none);
+
+    for (uword i = 0; i < d; ++i) {
+      RRngBlock::fill_randg(C.colptr(i), n, 0.5 * (df_ - static_cast<double>(i)), 2.0);
+    }
+
+    Cube<eT> W(d, d, n, fill::none);
+
+    const eT* L = L_.memptr();
+
+#pragma omp parallel for schedule(static) if (n * d * d * d > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword k = 0; k < n; ++k) {
+      std::vector<eT> A(d * d, eT(0));
+      std::vector<eT> B(d * d, eT(0));
+
+      const eT* z = Z.colptr(k);
+
+      for (uword j = 0, idx = 0; j < d; ++j) {
+        A[j + j * d] = std::sqrt(C.at(k, j));
+
+        for (uword i = j + 1; i < d; ++i, ++idx) {
+          A[i + j * d] = z[idx];
+        }
+      }
+
+      // B = L A, both lower triangular
+      for (uword j = 0; j < d; ++j) {
+        for (uword i = j; i < d; ++i) {
+          eT acc = eT(0);
+
+          for (uword m = j; m <= i; ++m) {
+            acc += L[i + m * d] * A[m + j * d];
+          }
+
+          B[i + j * d] = acc;
+        }
+      }
+
+      // W = B B'
+      eT* w = W.slice_memptr(k);
+
+      for (uword j = 0; j < d; ++j) {
+        for (uword i = j; i < d; ++i) {
+          eT acc = eT(0);
+
+          for (uword m = 0; m <= j; ++m) {
+            acc += B[i + m * d] * B[j + m * d];
+          }
+
+          w[i + j * d] = acc;
+          w[j + i * d] = acc;
+        }
+      }
+    }
+
+    return W;
+  }
+
+ private:
+  double df_;
+  Mat<eT> L_;
+};
+
+#endif
@@ -16,136 +16,214 @@ inline SpMat<T> as_SpMat(const T& x) {
   throw std::runtime_error("Cannot convert to SpMat");
 }
 
-template <typename T, typename U>
-inline SpMat<T> dblint_matrix_to_SpMat_(const U& x) {
-  const size_t n = x.nrow();
-  const size_t m = x.ncol();
+// Dense (column-major) to CSC conversion in two passes over the columns: count the
+// entries to keep in each column, turn the counts into column pointers with a prefix
+// sum, and fill the row indices and values of each column independently.
+// Entries with |x| <= tol are dropped (tol = 0 only drops exact zeros, NaN is kept),
+// and so are the ones that become zero when converted to T (e.g. 1e-50 as float).
+
+template <typename T, typename S>
+inline SpMat<T> dense_to_SpMat_(const S* src, const uword n, const uword m,
+                                const double tol) {
+  const auto keep = [tol](const S x) {
+    return !(std::abs(static_cast<double>(x)) <= tol) && static_cast<T>(x) != T(0);
+  };
+
+  Col<uword> col_ptrs(m + 1);
+  uword* counts = col_ptrs.memptr();
+  counts[0] = 0;
+
+#pragma omp parallel for schedule(static) if (n * m > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword j = 0; j < m; ++j) {
+    const S* col = src + j * n;
+    uword count = 0;
+
+    for (uword i = 0; i < n; ++i) {
+      count += keep(col[i]);
+    }
 
-  SpMat<T> y(n, m);
+    counts[j + 1] = count;
+  }
+
+  for (uword j = 0; j < m; ++j) {
+    counts[j + 1] += counts[j];
+  }
 
-  std::vector<std::pair<size_t, size_t>> non_zero_positions;
+  SpMat<T> y;
+  y.reserve(n, m, counts[m]);
 
-  for (size_t i = 0; i < n; ++i) {
-    for (size_t j = 0; j < m; ++j) {
-      if (x(i, j) != 0) {
-        non_zero_positions.emplace_back(i, j);
+  std::memcpy(access::rwp(y.col_ptrs), counts, (m + 1) * sizeof(uword));
+
+  uword* row_indices = access::rwp(y.row_indices);
+  T* values = access::rwp(y.values);
+
+#pragma omp parallel for schedule(static) if (n * m > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword j = 0; j < m; ++j) {
+    const S* col = src + j * n;
+    uword k = counts[j];
+
+    for (uword i = 0; i < n; ++i) {
+      if (keep(col[i])) {
+        row_indices[k] = i;
+        values[k] = static_cast<T>(col[i]);
+        ++k;
       }
     }
   }
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-  for (size_t k = 0; k < non_zero_positions.size(); ++k) {
-    const auto& pos = non_zero_positions[k];
-    y(pos.first, pos.second) = x(pos.first, pos.second);
-  }
-
   return y;
 }
 
 template <typename T, typename U>
-inline SpMat<T> dblint_to_SpMat_(const U& x) {
-  const size_t n = x.size();
+inline SpMat<T> dblint_matrix_to_SpMat_(const U& x, const double tol = 0) {
+  const uword n = x.nrow();
+  const uword m = x.ncol();
+
+  if (std::is_same<U, doubles_matrix<>>::value) {
+    return dense_to_SpMat_<T>(REAL(x.data()), n, m, tol);
+  } else {
+    return dense_to_SpMat_<T>(INTEGER(x.data()), n, m, tol);
+  }
+}
 
-  SpMat<T> y(n, 1);
+template <typename T, typename U>
+inline SpMat<T> dblint_to_SpMat_(const U& x, const double tol = 0) {
+  const uword n = as_uword_(x.size());
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-  for (size_t i = 0; i < n; ++i) {
-    y(i, 0) = x[i];
+  if (std::is_same<U, doubles>::value) {
+    return dense_to_SpMat_<T>(REAL(x.data()), n, 1, tol);
+  } else {
+    return dense_to_SpMat_<T>(INTEGER(x.data()), n, 1, tol);
   }
-
-  return y;
 }
 
-inline SpMat<double> as_SpMat(const doubles_matrix<>& x) {
-  return dblint_matrix_to_SpMat_<double, doubles_matrix<>>(x);
+inline SpMat<double> as_SpMat(const doubles_matrix<>& x, const double tol = 0) {
+  return dblint_matrix_to_SpMat_<double, doubles_matrix<>>(x, tol);
 }
 
-inline SpMat<int> as_SpMat(const integers_matrix<>& x) {
-  return dblint_matrix_to_SpMat_<int, integers_matrix<>>(x);
+inline SpMat<int> as_SpMat(const integers_matrix<>& x, const double tol = 0) {
+  return dblint_matrix_to_SpMat_<int, integers_matrix<>>(x, tol);
 }
 
-inline SpMat<double> as_SpMat(const doubles& x) {
-  return dblint_to_SpMat_<double, doubles>(x);
+inline SpMat<double> as_SpMat(const doubles& x, const double tol = 0) {
+  return dblint_to_SpMat_<double, doubles>(x, tol);
 }
 
-inline SpMat<int> as_SpMat(const integers& x) {
-  return dblint_to_SpMat_<int, integers>(x);
+inline SpMat<int> as_SpMat(const integers& x, const double tol = 0) {
+  return dblint_to_SpMat_<int, integers>(x, tol);
 }
 
 inline SpMat<double> as_sp_dmat(const doubles_matrix<>& x) { return as_SpMat(x); }
+
+// The element type conversion happens while filling the CSC arrays, without a
+// temporary SpMat<double> or SpMat<int>
+
 inline SpMat<float> as_sp_fmat(const doubles_matrix<>& x) {
-  SpMat<double> y = dblint_matrix_to_SpMat_<double, doubles_matrix<>>(x);
-  return arma::conv_to<SpMat<float>>::from(y);
+  return dblint_matrix_to_SpMat_<float, doubles_matrix<>>(x);
 }
 
 inline SpMat<uword> as_sp_umat(const integers_matrix<>& x) {
-  SpMat<int> y = dblint_matrix_to_SpMat_<int, integers_matrix<>>(x);
-  return arma::conv_to<SpMat<uword>>::from(y);
+  return dblint_matrix_to_SpMat_<uword, integers_matrix<>>(x);
 }
 
 inline SpMat<sword> as_sp_imat(const integers_matrix<>& x) {
-  SpMat<int> y = dblint_matrix_to_SpMat_<int, integers_matrix<>>(x);
-  return arma::conv_to<SpMat<sword>>::from(y);
+  return dblint_matrix_to_SpMat_<sword, integers_matrix<>>(x);
 }
 
 ////////////////////////////////////////////////////////////////
 // Armadillo to R
 ////////////////////////////////////////////////////////////////
 
+// Scatter the CSC arrays of A into a zero-initialised dense column-major array.
+// Each column is cleared and filled independently, which costs O(n * m + nnz)
+// instead of one binary search per element.
+
+template <typename T, typename D, typename F>
+inline void SpMat_scatter_(const SpMat<T>& A, D* B_data, F convert) {
+  A.sync();
+
+  const uword n = A.n_rows;
+  const uword m = A.n_cols;
+
+  const uword* col_ptrs = A.col_ptrs;     // length m+1
+  const uword* row_inds = A.row_indices;  // length nnz
+  const T* values = A.values;             // length nnz
+
+#pragma omp parallel for schedule(static) if (n * m > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword j = 0; j < m; ++j) {
+    D* col = B_data + j * n;
+
+    std::fill(col, col + n, D(0));
+
+    for (uword idx = col_ptrs[j]; idx < col_ptrs[j + 1]; ++idx) {
+      col[row_inds[idx]] = convert(values[idx]);
+    }
+  }
+}
+
 // Double/Integer
 
 template <typename T, typename U>
 inline U SpMat_to_dblint_matrix_(const SpMat<T>& A) {
-  const size_t n = A.n_rows;
-  const size_t m = A.n_cols;
-
-  using dblint_matrix =
-      typename std::conditional<std::is_same<U, doubles_matrix<>>::value,
-                                writable::doubles_matrix<>,
-                                writable::integers_matrix<>>::type;
+  const bool dbl = std::is_same<U, doubles_matrix<>>::value;
 
-  dblint_matrix B(n, m);
+  sexp B = alloc_matrix_(dbl ? REALSXP : INTSXP, A.n_rows, A.n_cols);
 
-#ifdef _OPENMP
-#pragma omp parallel for collapse(2) schedule(static)
-#endif
-  for (size_t i = 0; i < n; ++i) {
-    for (size_t j = 0; j < m; ++j) {
-      B(i, j) = A(i, j);
-    }
+  if (dbl) {
+    SpMat_scatter_(A, REAL(B), [](const T& v) { return static_cast<double>(v); });
+  } else {
+    SpMat_scatter_(A, INTEGER(B), [](const T& v) {
+      return fits_int_(v) ? static_cast<int>(v) : NA_INTEGER;
+    });
   }
 
-  return B;
+  return U(B);
 }
 
 inline doubles_matrix<> as_doubles_matrix(const SpMat<double>& A) {
   return SpMat_to_dblint_matrix_<double, doubles_matrix<>>(A);
 }
 
+inline doubles_matrix<> as_doubles_matrix(const SpMat<float>& A) {
+  return SpMat_to_dblint_matrix_<float, doubles_matrix<>>(A);
+}
+
 // Always provide for SpMat<int>
 inline integers_matrix<> as_integers_matrix(const SpMat<int>& A) {
   return SpMat_to_dblint_matrix_<int, integers_matrix<>>(A);
 }
 
-inline doubles_matrix<> as_doubles_matrix(const SpMat<float>& A) {
-  SpMat<double> B = arma::conv_to<SpMat<double>>::from(A);
-  return as_doubles_matrix(B);
+// sp_umat, sp_imat and other integer types, with an explicit cast to int
+
+template <typename T>
+inline integers_matrix<> as_integers_matrix(const SpMat<T>& A) {
+  return SpMat_to_dblint_matrix_<T, integers_matrix<>>(A);
+}
+
+inline integers_matrix<> as_integers_matrix(const SpMat<unsigned long long>& A) {
+  return as_integers_matrix<unsigned long long>(A);
+}
+
+inline integers_matrix<> as_integers_matrix(const SpMat<long long>& A) {
+  return as_integers_matrix<long long>(A);
 }
 
 // Complex
 
 template <typename T>
 inline list SpMat_to_complex_matrix_(const SpMat<T>& A) {
-  SpMat<double> A_real = real(A);
-  SpMat<double> A_imag = imag(A);
+  sexp A_real = alloc_matrix_(REALSXP, A.n_rows, A.n_cols);
+  sexp A_imag = alloc_matrix_(REALSXP, A.n_rows, A.n_cols);
+
+  SpMat_scatter_(A, REAL(A_real), [](const T& v) { return double(std::real(v)); });
+  SpMat_scatter_(A, REAL(A_imag), [](const T& v) { return double(std::imag(v)); });
 
   writable::list B;
-  B.push_back({"real"_nm = as_doubles_matrix(A_real)});
-  B.push_back({"imag"_nm = as_doubles_matrix(A_imag)});
+  B.push_back({"real"_nm = A_real});
+  B.push_back({"imag"_nm = A_imag});
 
   return B;
 }
@@ -157,7 +235,7 @@ inline list as_complex_matrix(const SpMat<std::complex<double>>& A) {
 #endif
 
 ////////////////////////////////////////////////////////////////
-// dgCMatrix to Armadillo
+// Matrix package sparse classes to Armadillo
 ////////////////////////////////////////////////////////////////
 
 // reference:
@@ -166,87 +244,736 @@ inline list as_complex_matrix(const SpMat<std::complex<double>>& A) {
 
 inline bool is_dgCMatrix(SEXP x) { return Rf_inherits(x, "dgCMatrix"); }
 
-inline SpMat<double> as_SpMat(SEXP x) {
-  if (!is_dgCMatrix(x)) {
-    stop("Input is not a dgCMatrix");
+// Sparse classes are named [dln][gst][CTR]Matrix: double/logical/pattern values,
+// general/symmetric/triangular structure, and column/triplet/row storage.
+// Returns the class name, also for S4 classes that extend one of them, or an empty
+// string for any other object.
+
+inline std::string sparse_Matrix_class_(SEXP x) {
+  static const char* valid[] = {
+      "dgCMatrix", "dsCMatrix", "dtCMatrix", "dgTMatrix", "dsTMatrix", "dtTMatrix",
+      "dgRMatrix", "dsRMatrix", "dtRMatrix", "lgCMatrix", "lsCMatrix", "ltCMatrix",
+      "lgTMatrix", "lsTMatrix", "ltTMatrix", "lgRMatrix", "lsRMatrix", "ltRMatrix",
+      "ngCMatrix", "nsCMatrix", "ntCMatrix", "ngTMatrix", "nsTMatrix", "ntTMatrix",
+      "ngRMatrix", "nsRMatrix", "ntRMatrix", ""};
+
+  if (!Rf_isObject(x)) {
+    return std::string();
+  }
+
+  const int i = R_check_class_etc(x, valid);
+
+  return (i < 0) ? std::string() : std::string(valid[i]);
+}
+
+// Values of the 'x' slot: doubles, logicals (NA becomes NaN) or none for pattern
+// matrices, where every stored entry is one
+
+template <typename T>
+inline T sparse_value_(const double* values, const uword k) {
+  return static_cast<T>(values[k]);
+}
+
+template <typename T>
+inline T sparse_value_(const int* values, const uword k) {
+  if (values == nullptr) {
+    return T(1);
+  }
+
+  return values[k] == NA_LOGICAL ? std::numeric_limits<T>::quiet_NaN()
+                                 : static_cast<T>(values[k]);
+}
+
+// Duplicated triplets are added for doubles and combined with OR for logicals
+
+template <typename T>
+inline T sparse_merge_(const double*, const T a, const T b) {
+  return a + b;
+}
+
+template <typename T>
+inline T sparse_merge_(const int*, const T a, const T b) {
+  return (a != T(0) || b != T(0)) ? T(1) : T(0);
+}
+
+// Column (or row) pointers must start at zero, end at nnz and never decrease
+
+inline void check_sparse_ptrs_(SEXP ptr_slot, const uword n, const uword nnz,
+                               const std::string& cls) {
+  const int* ptrs = INTEGER(ptr_slot);
+
+  if (static_cast<uword>(Rf_xlength(ptr_slot)) != n + 1 || ptrs[0] != 0 ||
+      static_cast<uword>(ptrs[n]) != nnz) {
+    stop("Invalid %s: inconsistent index and value slots", cls.c_str());
+  }
+
+  for (uword j = 0; j < n; ++j) {
+    if (ptrs[j] > ptrs[j + 1]) {
+      stop("Invalid %s: 'p' slot is not increasing", cls.c_str());
+    }
+  }
+}
+
+// Triplets to CSC: bucket the entries by column (counting sort), then sort each
+// column by row, merge duplicates and drop zeros in parallel, and compact the columns
+// into the SpMat
+
+template <typename T, typename S>
+inline SpMat<T> triplet_to_SpMat_(const int* rows, const int* cols, const S* values,
+                                  const uword n_rows, const uword n_cols,
+                                  const uword nnz, const bool trust_sorted,
+                                  const std::string& cls) {
+  if (!trust_sorted) {
+    bool in_range = true;
+
+#pragma omp parallel for reduction(&& : in_range) schedule(static) if (nnz > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword k = 0; k < nnz; ++k) {
+      in_range = in_range && (rows[k] >= 0) && (static_cast<uword>(rows[k]) < n_rows) &&
+                 (cols[k] >= 0) && (static_cast<uword>(cols[k]) < n_cols);
+    }
+
+    if (!in_range) {
+      stop("Invalid %s: index out of bounds", cls.c_str());
+    }
+  }
+
+  std::vector<uword> start(n_cols + 1, 0);
+
+  for (uword k = 0; k < nnz; ++k) {
+    ++start[cols[k] + 1];
+  }
+
+  for (uword j = 0; j < n_cols; ++j) {
+    start[j + 1] += start[j];
+  }
+
+  std::vector<std::pair<uword, T>> entries(nnz);
+
+  {
+    std::vector<uword> pos(start.begin(), start.end() - 1);
+
+    for (uword k = 0; k < nnz; ++k) {
+      entries[pos[cols[k]]++] = {static_cast<uword>(rows[k]), sparse_value_<T>(values, k)};
+    }
+  }
+
+  const auto by_row = [](const std::pair<uword, T>& a, const std::pair<uword, T>& b) {
+    return a.first < b.first;
+  };
+
+  std::vector<uword> counts(n_cols);
+
+#pragma omp parallel for schedule(dynamic, 256) if (nnz > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword j = 0; j < n_cols; ++j) {
+    const auto first = entries.begin() + start[j];
+    const auto last = entries.begin() + start[j + 1];
+
+    if (!std::is_sorted(first, last, by_row)) {
+      std::sort(first, last, by_row);
+    }
+
+    // merge duplicates first, a sum can cancel out to zero
+    auto out = first;
+    for (auto it = first; it != last; ++it) {
+      if (out != first && (out - 1)->first == it->first) {
+        (out - 1)->second = sparse_merge_(values, (out - 1)->second, it->second);
+      } else {
+        *out++ = *it;
+      }
+    }
+
+    const auto end = std::remove_if(
+        first, out, [](const std::pair<uword, T>& e) { return e.second == T(0); });
+
+    counts[j] = static_cast<uword>(end - first);
+  }
+
+  SpMat<T> y;
+  y.reserve(n_rows, n_cols, std::accumulate(counts.begin(), counts.end(), uword(0)));
+
+  uword* y_col_ptrs = access::rwp(y.col_ptrs);
+  uword* y_row_indices = access::rwp(y.row_indices);
+  T* y_values = access::rwp(y.values);
+
+  y_col_ptrs[0] = 0;
+  for (uword j = 0; j < n_cols; ++j) {
+    y_col_ptrs[j + 1] = y_col_ptrs[j] + counts[j];
+  }
+
+#pragma omp parallel for schedule(static) if (nnz > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword j = 0; j < n_cols; ++j) {
+    for (uword k = 0; k < counts[j]; ++k) {
+      y_row_indices[y_col_ptrs[j] + k] = entries[start[j] + k].first;
+      y_values[y_col_ptrs[j] + k] = entries[start[j] + k].second;
+    }
+  }
+
+  return y;
+}
+
+// Copy the CSC slots straight into the CSC arrays of a SpMat.
+// Objects created by the Matrix package are already sorted and free of duplicates,
+// so with trust_sorted = true the slots are copied without validating the indices.
+// Otherwise the slots are validated in the same pass and unsorted inputs go through
+// the triplet conversion, which sorts the locations.
+
+template <typename T, typename S>
+inline SpMat<T> csc_to_SpMat_(const int* row_indices, const int* col_ptrs,
+                              const S* values, const uword n_rows, const uword n_cols,
+                              const uword nnz, const bool trust_sorted,
+                              const std::string& cls) {
+  bool sorted = true;
+  bool has_zeros = false;
+
+  if (!trust_sorted) {
+    bool in_range = true;
+
+#pragma omp parallel for reduction(&& : in_range, sorted) reduction(|| : has_zeros) \
+    schedule(static) if (nnz > 10000) num_threads(Parallel::max_threads())
+    for (uword j = 0; j < n_cols; ++j) {
+      const int start = col_ptrs[j];
+      const int end = col_ptrs[j + 1];
+
+      for (int k = start; k < end; ++k) {
+        const int row = row_indices[k];
+
+        in_range = in_range && (row >= 0) && (static_cast<uword>(row) < n_rows);
+        sorted = sorted && (k == start || row_indices[k - 1] < row);
+        has_zeros = has_zeros || (sparse_value_<T>(values, k) == T(0));
+      }
+    }
+
+    if (!in_range) {
+      stop("Invalid %s: row index out of bounds", cls.c_str());
+    }
+  }
+
+  if (!sorted) {
+    std::vector<int> cols(nnz);
+
+#pragma omp parallel for schedule(static) if (nnz > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword j = 0; j < n_cols; ++j) {
+      std::fill(cols.begin() + col_ptrs[j], cols.begin() + col_ptrs[j + 1],
+                static_cast<int>(j));
+    }
+
+    return triplet_to_SpMat_<T, S>(row_indices, cols.data(), values, n_rows, n_cols,
+                                   nnz, true, cls);
+  }
+
+  SpMat<T> y;
+  y.reserve(n_rows, n_cols, nnz);
+
+  uword* y_col_ptrs = access::rwp(y.col_ptrs);
+  uword* y_row_indices = access::rwp(y.row_indices);
+  T* y_values = access::rwp(y.values);
+
+  if (sizeof(uword) == sizeof(int)) {
+    // indices are non-negative, so int and 32-bit uword share the same representation
+    std::memcpy(y_col_ptrs, col_ptrs, (n_cols + 1) * sizeof(int));
+    std::memcpy(y_row_indices, row_indices, nnz * sizeof(int));
+  } else {
+#pragma omp parallel for schedule(static) if (n_cols > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword j = 0; j <= n_cols; ++j) {
+      y_col_ptrs[j] = static_cast<uword>(col_ptrs[j]);
+    }
+
+#pragma omp parallel for schedule(static) if (nnz > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword k = 0; k < nnz; ++k) {
+      y_row_indices[k] = static_cast<uword>(row_indices[k]);
+    }
+  }
+
+  if (std::is_same<T, double>::value && std::is_same<S, double>::value) {
+    std::memcpy(y_values, values, nnz * sizeof(double));
+  } else {
+#pragma omp parallel for schedule(static) if (nnz > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword k = 0; k < nnz; ++k) {
+      y_values[k] = sparse_value_<T>(values, k);
+    }
+  }
+
+  // Armadillo does not store explicit zeros. Trusted slots were not scanned, and they
+  // can still hold zeros (e.g. after setting x[i] <- 0, or FALSE in logical matrices);
+  // remove_zeros() only rebuilds the arrays when it finds one.
+  if (trust_sorted || has_zeros) {
+    y.remove_zeros();
+  }
+
+  return y;
+}
+
+// Symmetric matrices store one triangle. The full matrix is built in CSC directly:
+// each column holds its stored part plus the mirrored entries of the other columns,
+// which arrive in increasing row order when the columns are visited in order.
+
+template <typename T>
+inline SpMat<T> symmetric_to_SpMat_(const SpMat<T>& A, const bool upper,
+                                    const bool trust_sorted, const std::string& cls) {
+  const uword n = A.n_cols;
+
+  if (!trust_sorted) {
+    bool in_triangle = true;
+
+#pragma omp parallel for reduction(&& : in_triangle) schedule(static) if (n > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword j = 0; j < n; ++j) {
+      const uword start = A.col_ptrs[j];
+      const uword end = A.col_ptrs[j + 1];
+
+      if (start < end) {
+        in_triangle = in_triangle && (upper ? A.row_indices[end - 1] <= j
+                                            : A.row_indices[start] >= j);
+      }
+    }
+
+    if (A.n_rows != n || !in_triangle) {
+      stop("Invalid %s: entries outside of the '%s' triangle", cls.c_str(),
+           upper ? "U" : "L");
+    }
+  }
+
+  // number of mirrored entries in each column
+  std::vector<uword> mirrored(n, 0);
+
+  for (uword j = 0; j < n; ++j) {
+    for (uword k = A.col_ptrs[j]; k < A.col_ptrs[j + 1]; ++k) {
+      if (A.row_indices[k] != j) {
+        ++mirrored[A.row_indices[k]];
+      }
+    }
+  }
+
+  SpMat<T> y;
+  y.reserve(n, n,
+            A.n_nonzero + std::accumulate(mirrored.begin(), mirrored.end(), uword(0)));
+
+  uword* y_col_ptrs = access::rwp(y.col_ptrs);
+  uword* y_row_indices = access::rwp(y.row_indices);
+  T* y_values = access::rwp(y.values);
+
+  y_col_ptrs[0] = 0;
+  for (uword j = 0; j < n; ++j) {
+    y_col_ptrs[j + 1] = y_col_ptrs[j] + (A.col_ptrs[j + 1] - A.col_ptrs[j]) + mirrored[j];
+  }
+
+  // stored part: first in the upper case (rows <= j), last in the lower case (rows >= j)
+#pragma omp parallel for schedule(static) if (A.n_nonzero > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword j = 0; j < n; ++j) {
+    const uword offset = y_col_ptrs[j] + (upper ? 0 : mirrored[j]);
+    const uword len = A.col_ptrs[j + 1] - A.col_ptrs[j];
+
+    std::copy(A.row_indices + A.col_ptrs[j], A.row_indices + A.col_ptrs[j + 1],
+              y_row_indices + offset);
+    std::copy(A.values + A.col_ptrs[j], A.values + A.col_ptrs[j] + len, y_values + offset);
+  }
+
+  // mirrored part: after the stored part in the upper case, before it in the lower case
+  std::vector<uword> pos(n);
+
+  for (uword j = 0; j < n; ++j) {
+    pos[j] = upper ? y_col_ptrs[j + 1] - mirrored[j] : y_col_ptrs[j];
+  }
+
+  for (uword j = 0; j < n; ++j) {
+    for (uword k = A.col_ptrs[j]; k < A.col_ptrs[j + 1]; ++k) {
+      const uword row = A.row_indices[k];
+
+      if (row != j) {
+        y_row_indices[pos[row]] = j;
+        y_values[pos[row]] = A.values[k];
+        ++pos[row];
+      }
+    }
   }
 
-  // Extract the slots from dgCMatrix
-  SEXP i_slot = R_do_slot(x, Rf_mkString("i"));      // Row indices
-  SEXP p_slot = R_do_slot(x, Rf_mkString("p"));      // Column pointers
-  SEXP x_slot = R_do_slot(x, Rf_mkString("x"));      // Values
-  SEXP dim_slot = R_do_slot(x, Rf_mkString("Dim"));  // Dimensions
+  return y;
+}
+
+// Unit triangular matrices (diag = "U") do not store their diagonal, insert it in
+// each column at its sorted position
 
-  // Dimensions
-  int n_rows = INTEGER(dim_slot)[0];
-  int n_cols = INTEGER(dim_slot)[1];
+template <typename T>
+inline SpMat<T> unit_triangular_to_SpMat_(const SpMat<T>& A) {
+  const uword n_cols = A.n_cols;
+  const uword n_diag = std::min(A.n_rows, A.n_cols);
+
+  std::vector<uword> pos(n_cols);
+  std::vector<int> has_diag(n_cols, 0);
+
+#pragma omp parallel for schedule(static) if (A.n_nonzero > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword j = 0; j < n_cols; ++j) {
+    const uword* first = A.row_indices + A.col_ptrs[j];
+    const uword* last = A.row_indices + A.col_ptrs[j + 1];
+    const uword* it = std::lower_bound(first, last, j);
+
+    pos[j] = static_cast<uword>(it - first);
+    has_diag[j] = (j >= n_diag) || (it != last && *it == j);
+  }
+
+  SpMat<T> y;
+  y.reserve(A.n_rows, n_cols,
+            A.n_nonzero + std::count(has_diag.begin(), has_diag.end(), 0));
+
+  uword* y_col_ptrs = access::rwp(y.col_ptrs);
+  uword* y_row_indices = access::rwp(y.row_indices);
+  T* y_values = access::rwp(y.values);
+
+  y_col_ptrs[0] = 0;
+  for (uword j = 0; j < n_cols; ++j) {
+    y_col_ptrs[j + 1] =
+        y_col_ptrs[j] + (A.col_ptrs[j + 1] - A.col_ptrs[j]) + (has_diag[j] ? 0 : 1);
+  }
 
-  // Row indices, column pointers and values
-  int* row_indices = INTEGER(i_slot);
-  int* col_ptrs = INTEGER(p_slot);
-  double* values = REAL(x_slot);
+#pragma omp parallel for schedule(static) if (A.n_nonzero > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword j = 0; j < n_cols; ++j) {
+    uword dst = y_col_ptrs[j];
 
-  // Number of non-zero elements
-  int nnz = LENGTH(x_slot);
+    for (uword k = A.col_ptrs[j]; k < A.col_ptrs[j + 1]; ++k) {
+      if (k == A.col_ptrs[j] + pos[j] && !has_diag[j]) {
+        y_row_indices[dst] = j;
+        y_values[dst++] = T(1);
+      }
 
-  // Create a temporary array for row indices and column pointers
-  arma::umat locations(2, nnz);
-  arma::vec vals(nnz);
+      y_row_indices[dst] = A.row_indices[k];
+      y_values[dst++] = (A.row_indices[k] == j) ? T(1) : A.values[k];
+    }
 
-  // Convert CSC format to coordinate list format
-  int k = 0;
-  for (int j = 0; j < n_cols; j++) {
-    for (int p = col_ptrs[j]; p < col_ptrs[j + 1]; p++) {
-      locations(0, k) = row_indices[p];  // Row
-      locations(1, k) = j;               // Column
-      vals(k) = values[p];               // Value
-      k++;
+    if (dst < y_col_ptrs[j + 1]) {
+      y_row_indices[dst] = j;
+      y_values[dst] = T(1);
     }
   }
 
-  // Create sparse matrix from locations and values
-  return SpMat<double>(locations, vals, n_rows, n_cols);
+  return y;
+}
+
+// Entries stored in the slots, following the storage letter (C, T or R)
+
+template <typename T, typename S>
+inline SpMat<T> sparse_slots_to_SpMat_(SEXP x, const S* values, const uword n_rows,
+                                       const uword n_cols, const bool trust_sorted,
+                                       const std::string& cls) {
+  const char storage = cls[2];
+
+  // the index slot has one element per stored entry
+  SEXP idx_slot = R_do_slot(x, Rf_install(storage == 'R' ? "j" : "i"));
+  const uword nnz = Rf_xlength(idx_slot);
+
+  if (!trust_sorted && cls[0] != 'n' &&
+      static_cast<uword>(Rf_xlength(R_do_slot(x, Rf_install("x")))) != nnz) {
+    stop("Invalid %s: inconsistent index and value slots", cls.c_str());
+  }
+
+  if (storage == 'C') {
+    SEXP p_slot = R_do_slot(x, Rf_install("p"));
+
+    if (!trust_sorted) {
+      check_sparse_ptrs_(p_slot, n_cols, nnz, cls);
+    }
+
+    return csc_to_SpMat_<T, S>(INTEGER(idx_slot), INTEGER(p_slot), values, n_rows,
+                               n_cols, nnz, trust_sorted, cls);
+  }
+
+  if (storage == 'T') {
+    SEXP j_slot = R_do_slot(x, Rf_install("j"));
+
+    if (static_cast<uword>(Rf_xlength(j_slot)) != nnz) {
+      stop("Invalid %s: inconsistent index and value slots", cls.c_str());
+    }
+
+    return triplet_to_SpMat_<T, S>(INTEGER(idx_slot), INTEGER(j_slot), values, n_rows,
+                                   n_cols, nnz, trust_sorted, cls);
+  }
+
+  // row storage, expand the row pointers and bucket the entries by column
+  SEXP p_slot = R_do_slot(x, Rf_install("p"));
+
+  if (!trust_sorted) {
+    check_sparse_ptrs_(p_slot, n_rows, nnz, cls);
+  }
+
+  const int* row_ptrs = INTEGER(p_slot);
+  std::vector<int> rows(nnz);
+
+#pragma omp parallel for schedule(static) if (nnz > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword i = 0; i < n_rows; ++i) {
+    std::fill(rows.begin() + row_ptrs[i], rows.begin() + row_ptrs[i + 1],
+              static_cast<int>(i));
+  }
+
+  return triplet_to_SpMat_<T, S>(rows.data(), INTEGER(idx_slot), values, n_rows, n_cols,
+                                 nnz, trust_sorted, cls);
+}
+
+// Any [dln][gst][CTR]Matrix to SpMat without calling R to coerce it. Symmetric
+// matrices are expanded, unless expand_symmetric = false, which keeps the stored
+// triangle only.
+
+template <typename T>
+inline SpMat<T> sparse_Matrix_to_SpMat_(SEXP x, const bool trust_sorted,
+                                        const bool expand_symmetric) {
+  const std::string cls = sparse_Matrix_class_(x);
+
+  if (cls.empty()) {
+    stop("Input is not a sparse matrix from the Matrix package");
+  }
+
+  SEXP dim_slot = R_do_slot(x, Rf_install("Dim"));  // Dimensions
+
+  const uword n_rows = INTEGER(dim_slot)[0];
+  const uword n_cols = INTEGER(dim_slot)[1];
+
+  SpMat<T> y;
+
+  if (cls[0] == 'd') {
+    y = sparse_slots_to_SpMat_<T, double>(x, REAL(R_do_slot(x, Rf_install("x"))),
+                                          n_rows, n_cols, trust_sorted, cls);
+  } else if (cls[0] == 'l') {
+    y = sparse_slots_to_SpMat_<T, int>(x, LOGICAL(R_do_slot(x, Rf_install("x"))),
+                                       n_rows, n_cols, trust_sorted, cls);
+  } else {
+    y = sparse_slots_to_SpMat_<T, int>(x, nullptr, n_rows, n_cols, trust_sorted, cls);
+  }
+
+  if (cls[1] == 'g') {
+    return y;
+  }
+
+  const bool upper = CHAR(STRING_ELT(R_do_slot(x, Rf_install("uplo")), 0))[0] == 'U';
+
+  if (cls[1] == 's') {
+    return expand_symmetric ? symmetric_to_SpMat_(y, upper, trust_sorted, cls) : y;
+  }
+
+  const bool unit = CHAR(STRING_ELT(R_do_slot(x, Rf_install("diag")), 0))[0] == 'U';
+
+  return unit ? unit_triangular_to_SpMat_(y) : y;
+}
+
+inline SpMat<double> as_SpMat(SEXP x, const bool trust_sorted = false,
+                              const bool expand_symmetric = true) {
+  return sparse_Matrix_to_SpMat_<double>(x, trust_sorted, expand_symmetric);
+}
+
+inline SpMat<float> as_sp_fmat(SEXP x, const bool trust_sorted = false,
+                               const bool expand_symmetric = true) {
+  return sparse_Matrix_to_SpMat_<float>(x, trust_sorted, expand_symmetric);
 }
 
 ////////////////////////////////////////////////////////////////
-// SpMat to dgCMatrix
+// SpMat to Matrix package sparse classes
 ////////////////////////////////////////////////////////////////
 
-inline SEXP as_dgCMatrix(const SpMat<double>& A) {
-  // Create data in triplet format (COO)
-  std::vector<int> i_vec, j_vec;
-  std::vector<double> x_vec;
+// Class definitions, looked up once and kept for the whole session
+
+inline SEXP Matrix_class_(const std::string& cls) {
+  static std::map<std::string, SEXP> classes;
+
+  auto it = classes.find(cls);
+
+  if (it == classes.end()) {
+    // make sure that the Matrix package (and its classes) is loaded
+    cpp11::safe[R_FindNamespace](Rf_mkString("Matrix"));
+
+    SEXP klass = cpp11::safe[R_do_MAKE_CLASS](cls.c_str());
+    R_PreserveObject(klass);
+
+    it = classes.emplace(cls, klass).first;
+  }
+
+  return it->second;
+}
+
+inline SEXP dgCMatrix_class_() { return Matrix_class_("dgCMatrix"); }
+
+// Fill a new object of class cls with the CSC arrays of A, no triplets nor
+// re-sorting. Symmetric and triangular classes keep the uplo triangle only, row
+// storage uses the CSC arrays of the transpose, and triplet storage expands the
+// column pointers.
+
+template <typename T>
+inline SEXP SpMat_to_sparse_Matrix_(const SpMat<T>& A, const std::string& cls,
+                                    const char uplo = 'U') {
+  const char kind = cls[0];
+  const char structure = cls[1];
+  const char storage = cls[2];
+
+  // the 'i' and 'p' slots are int vectors
+  if (A.n_nonzero > static_cast<uword>(std::numeric_limits<int>::max())) {
+    stop("Cannot convert to %s, too many non-zero elements", cls.c_str());
+  }
+
+  const SpMat<T> At = (storage == 'R') ? SpMat<T>(A.t()) : SpMat<T>();
+  const SpMat<T>& B = (storage == 'R') ? At : A;
+
+  B.sync();
+
+  const uword n_cols = B.n_cols;
+
+  // the triangle of A is the opposite one of its transpose
+  const char triangle =
+      (structure == 'g') ? 0 : ((storage == 'R') == (uplo == 'U') ? 'L' : 'U');
+
+  // column pointers of the entries that are kept
+  writable::integers p(n_cols + 1);
+  int* p_data = INTEGER(p);
+
+  p_data[0] = 0;
+
+  if (triangle == 0 && sizeof(uword) == sizeof(int)) {
+    std::memcpy(p_data, B.col_ptrs, (n_cols + 1) * sizeof(int));
+  } else {
+#pragma omp parallel for schedule(static) if (n_cols > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword j = 0; j < n_cols; ++j) {
+      const uword* start = B.row_indices + B.col_ptrs[j];
+      const uword* end = B.row_indices + B.col_ptrs[j + 1];
+
+      if (triangle == 'U') {
+        end = std::upper_bound(start, end, j);
+      } else if (triangle == 'L') {
+        start = std::lower_bound(start, end, j);
+      }
+
+      p_data[j + 1] = static_cast<int>(end - start);
+    }
+
+    for (uword j = 0; j < n_cols; ++j) {
+      p_data[j + 1] += p_data[j];
+    }
+  }
+
+  const uword nnz = p_data[n_cols];
+
+  writable::integers i(nnz);
+  int* i_data = INTEGER(i);
+
+  sexp x = (kind == 'n') ? sexp(R_NilValue)
+                         : sexp(alloc_vector_(kind == 'd' ? REALSXP : LGLSXP, nnz));
+
+  double* x_dbl = (kind == 'd') ? REAL(x) : nullptr;
+  int* x_lgl = (kind == 'l') ? LOGICAL(x) : nullptr;
 
-  i_vec.reserve(A.n_nonzero);
-  j_vec.reserve(A.n_nonzero);
-  x_vec.reserve(A.n_nonzero);
+  if (triangle == 0 && sizeof(uword) == sizeof(int)) {
+    std::memcpy(i_data, B.row_indices, nnz * sizeof(int));
+  }
+
+  if (triangle == 0 && kind == 'd' && std::is_same<T, double>::value) {
+    std::memcpy(x_dbl, B.values, nnz * sizeof(double));
+  }
+
+#pragma omp parallel for schedule(static) if (nnz > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword j = 0; j < n_cols; ++j) {
+    // offset of the kept entries within the column of B
+    const uword skip = (triangle == 'L') ? (B.col_ptrs[j + 1] - B.col_ptrs[j]) -
+                                               (p_data[j + 1] - p_data[j])
+                                         : 0;
+    const uword src = B.col_ptrs[j] + skip;
+
+    for (int k = p_data[j]; k < p_data[j + 1]; ++k) {
+      const uword s = src + (k - p_data[j]);
+
+      if (triangle != 0 || sizeof(uword) != sizeof(int)) {
+        i_data[k] = static_cast<int>(B.row_indices[s]);
+      }
+
+      if (kind == 'd') {
+        if (triangle != 0 || !std::is_same<T, double>::value) {
+          x_dbl[k] = static_cast<double>(B.values[s]);
+        }
+      } else if (kind == 'l') {
+        x_lgl[k] = std::isnan(static_cast<double>(B.values[s]))
+                            ? NA_LOGICAL
+                            : static_cast<int>(B.values[s] != T(0));
+      }
+    }
+  }
+
+  writable::integers dims = {as_dim_(A.n_rows), as_dim_(A.n_cols)};
+
+  sexp out = cpp11::safe[R_do_new_object](Matrix_class_(cls));
+
+  if (storage == 'C') {
+    R_do_slot_assign(out, Rf_install("i"), i);
+    R_do_slot_assign(out, Rf_install("p"), p);
+  } else if (storage == 'R') {
+    R_do_slot_assign(out, Rf_install("j"), i);
+    R_do_slot_assign(out, Rf_install("p"), p);
+  } else {
+    writable::integers j(nnz);
+    int* j_data = INTEGER(j);
 
-  // Extract non-zero elements
-  for (uword col = 0; col < A.n_cols; col++) {
-    for (SpMat<double>::const_iterator it = A.begin_col(col); it != A.end_col(col);
-         ++it) {
-      i_vec.push_back(it.row() + 1);  // 1-based indexing for R
-      j_vec.push_back(col + 1);       // 1-based indexing for R
-      x_vec.push_back(*it);
+#pragma omp parallel for schedule(static) if (nnz > 10000) \
+    num_threads(Parallel::max_threads())
+    for (uword c = 0; c < n_cols; ++c) {
+      std::fill(j_data + p_data[c], j_data + p_data[c + 1], static_cast<int>(c));
     }
+
+    R_do_slot_assign(out, Rf_install("i"), i);
+    R_do_slot_assign(out, Rf_install("j"), j);
   }
 
-  // Create R vectors using cpp11 instead of low-level SEXP manipulation
-  writable::integers i(i_vec.begin(), i_vec.end());
-  writable::integers j(j_vec.begin(), j_vec.end());
-  writable::doubles x(x_vec.begin(), x_vec.end());
-  writable::integers dims = {static_cast<int>(A.n_rows), static_cast<int>(A.n_cols)};
+  if (kind != 'n') {
+    R_do_slot_assign(out, Rf_install("x"), x);
+  }
 
-  // Get R functions from base environment
-  function getNamespace = function(Rf_findFun(Rf_install("getNamespace"), R_GlobalEnv));
-  SEXP Matrix_ns = getNamespace("Matrix");
+  R_do_slot_assign(out, Rf_install("Dim"), dims);
 
-  function get = function(Rf_findFun(Rf_install("get"), R_GlobalEnv));
-  SEXP sparseMatrix_fn = get("sparseMatrix", Matrix_ns);
+  if (structure != 'g') {
+    sexp uplo_slot = safe[Rf_mkString](uplo == 'U' ? "U" : "L");
+    R_do_slot_assign(out, Rf_install("uplo"), uplo_slot);
+  }
 
-  function sparseMatrix = function(sparseMatrix_fn);
+  return out;
+}
+
+template <typename T>
+inline SEXP SpMat_to_dgCMatrix_(const SpMat<T>& A) {
+  return SpMat_to_sparse_Matrix_<T>(A, "dgCMatrix");
+}
+
+inline SEXP as_dgCMatrix(const SpMat<double>& A) { return SpMat_to_dgCMatrix_<double>(A); }
+
+inline SEXP as_dgCMatrix(const SpMat<float>& A) { return SpMat_to_dgCMatrix_<float>(A); }
+
+inline SEXP as_dgTMatrix(const SpMat<double>& A) {
+  return SpMat_to_sparse_Matrix_<double>(A, "dgTMatrix");
+}
+
+inline SEXP as_dgRMatrix(const SpMat<double>& A) {
+  return SpMat_to_sparse_Matrix_<double>(A, "dgRMatrix");
+}
+
+// A is assumed to be symmetric, only the uplo triangle is stored
+
+inline SEXP as_dsCMatrix(const SpMat<double>& A, const char uplo = 'U') {
+  return SpMat_to_sparse_Matrix_<double>(A, "dsCMatrix", uplo);
+}
+
+// Entries outside of the uplo triangle are dropped
+
+inline SEXP as_dtCMatrix(const SpMat<double>& A, const char uplo = 'U') {
+  return SpMat_to_sparse_Matrix_<double>(A, "dtCMatrix", uplo);
+}
+
+inline SEXP as_lgCMatrix(const SpMat<double>& A) {
+  return SpMat_to_sparse_Matrix_<double>(A, "lgCMatrix");
+}
 
-  // Call sparseMatrix directly with named arguments
-  return sparseMatrix(named_arg("i") = i, named_arg("j") = j, named_arg("x") = x,
-                      named_arg("dims") = dims);
+inline SEXP as_ngCMatrix(const SpMat<double>& A) {
+  return SpMat_to_sparse_Matrix_<double>(A, "ngCMatrix");
 }
@@ -27,7 +27,7 @@ inline Col<T> as_Col(const Col<T>& x) {
 
 template <typename T, typename U>
 inline Col<T> as_Col_(const U& x) {
-  const size_t n = x.size();
+  const uword n = as_uword_(x.size());
 
   if (std::is_same<U, doubles>::value) {
     return Col<T>(reinterpret_cast<T*>(REAL(x.data())), n, false);
@@ -79,14 +79,57 @@ inline Col<double> as_col(const doubles& x) { return as_Col(x); }
 
 inline Col<int> as_col(const integers& x) { return as_Col(x); }
 
+// Complex vectors (CPLXSXP), no copy as Rcomplex and std::complex<double> share the
+// same layout
+
+inline Col<std::complex<double>> as_cx_vec(SEXP x) {
+  if (TYPEOF(x) != CPLXSXP) {
+    stop("Input is not a complex vector");
+  }
+
+  return Col<std::complex<double>>(reinterpret_cast<std::complex<double>*>(COMPLEX(x)),
+                                   as_uword_(Rf_xlength(x)), false, false);
+}
+
 inline uvec as_uvec(const cpp11::integers& x) {
-  uvec res(x.size());
+  uvec res(as_uword_(x.size()));
   // the binary representation of int and uword are not the same
   // reinterpret_cast fails
   std::copy(x.begin(), x.end(), res.begin());
   return res;
 }
 
+// R indices (1-based) to Armadillo indices (0-based), the shift and the checks for NA
+// and negative values are fused with the int to uword conversion
+
+inline uvec as_uvec_index(const cpp11::integers& x, const bool from_one_based = true) {
+  const uword n = as_uword_(x.size());
+  const unsigned int shift = from_one_based ? 1 : 0;
+
+  uvec res(n);
+
+  const int* src = INTEGER(x.data());
+  uword* dst = res.memptr();
+
+  // NA_INTEGER is the smallest int, so it is caught by the range check as well
+  int invalid = 0;
+
+#pragma omp parallel for simd reduction(| : invalid) schedule(static) if (n > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword i = 0; i < n; ++i) {
+    const int v = src[i];
+    invalid |= (v < static_cast<int>(shift));
+    dst[i] = static_cast<uword>(static_cast<unsigned int>(v) - shift);
+  }
+
+  if (invalid) {
+    stop(from_one_based ? "Invalid index: indices must be non-NA and >= 1"
+                        : "Invalid index: indices must be non-NA and >= 0");
+  }
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////
 // Armadillo to R
 ////////////////////////////////////////////////////////////////
@@ -95,22 +138,17 @@ inline uvec as_uvec(const cpp11::integers& x) {
 
 template <typename T, typename U>
 inline U Col_to_dblint_(const Col<T>& x) {
-  const size_t n = x.n_rows;
-
-  using dblint = typename std::conditional<std::is_same<U, doubles>::value,
-                                           writable::doubles, writable::integers>::type;
-
-  dblint y(n);
+  const uword n = x.n_rows;
 
   if (std::is_same<U, doubles>::value) {
-    double* y_data = REAL(y);
-    std::memcpy(y_data, x.memptr(), n * sizeof(double));
+    sexp y = alloc_vector_(REALSXP, n);
+    std::memcpy(REAL(y), x.memptr(), n * sizeof(double));
+    return U(y);
   } else {
-    int* y_data = INTEGER(y);
-    std::memcpy(y_data, x.memptr(), n * sizeof(int));
+    sexp y = alloc_vector_(INTSXP, n);
+    std::memcpy(INTEGER(y), x.memptr(), n * sizeof(int));
+    return U(y);
   }
-
-  return y;
 }
 
 inline integers as_integers(const Col<int>& x) {
@@ -118,27 +156,65 @@ inline integers as_integers(const Col<int>& x) {
   return Col_to_dblint_<int, integers>(x);
 }
 
+// long long and uword to int, values outside of the int range become NA
+
 inline integers as_integers(const Col<long long>& x) {
-  // Explicit cast for long long to int
-  const size_t n = x.n_elem;
-  writable::integers y(n);
-  const long long* x_data = x.memptr();
-  for (size_t i = 0; i < n; ++i) {
-    y[i] = static_cast<int>(x_data[i]);
-  }
-  return y;
+  sexp y = alloc_vector_(INTSXP, x.n_elem);
+  int_copy_(x.memptr(), INTEGER(y), x.n_elem);
+  return integers(y);
 }
 
 inline doubles as_doubles(const Col<double>& x) {
   return Col_to_dblint_<double, doubles>(x);
 }
 
+#if defined(CPP11ARMADILLO_USE_R_ALLOC)
+// A temporary that already lives inside an R vector is handed over instead of copied,
+// and left empty (see as_doubles_matrix(Mat<double>&&))
+
+inline doubles as_doubles(Col<double>&& x) {
+  sexp owner = RAllocator::take(x);
+
+  if (owner == R_NilValue) {
+    return Col_to_dblint_<double, doubles>(x);
+  }
+
+  Rf_setAttrib(owner, R_DimSymbol, R_NilValue);
+  return doubles(owner);
+}
+#endif
+
 inline integers as_integers(const uvec& x) {
-  const size_t n = x.n_elem;
+  sexp y = alloc_vector_(INTSXP, x.n_elem);
+  int_copy_(x.memptr(), INTEGER(y), x.n_elem);
+  return integers(y);
+}
+
+// Armadillo indices (0-based) to R indices (1-based), see as_uvec_index()
+
+inline integers as_integers_index(const uvec& x, const bool to_one_based = true) {
+  const uword n = x.n_elem;
+  const uword shift = to_one_based ? 1 : 0;
+  const uword max_index = static_cast<uword>(std::numeric_limits<int>::max()) - shift;
 
   writable::integers y(n);
 
-  std::copy(x.begin(), x.end(), y.begin());
+  const uword* src = x.memptr();
+  int* dst = INTEGER(y);
+
+  int invalid = 0;
+
+#pragma omp parallel for simd reduction(| : invalid) schedule(static) if (n > 10000) \
+    num_threads(Parallel::max_threads())
+  for (uword i = 0; i < n; ++i) {
+    const uword v = src[i];
+    invalid |= (v > max_index);
+    dst[i] = static_cast<int>(v + shift);
+  }
+
+  if (invalid) {
+    stop("Invalid index: indices must be smaller than the largest R integer");
+  }
 
   return y;
 }
@@ -146,7 +222,7 @@ inline integers as_integers(const uvec& x) {
 inline integers as_integers(const uword& x) {
   writable::integers y(1);
 
-  y[0] = static_cast<int>(x);
+  y[0] = fits_int_(x) ? static_cast<int>(x) : NA_INTEGER;
 
   return y;
 }
@@ -155,54 +231,104 @@ inline integers as_integers(const uword& x) {
 
 template <typename T, typename U>
 inline U Col_to_dblint_matrix_(const Col<T>& x) {
-  const size_t n = x.n_rows;
-  const size_t m = 1;
+  const int n = as_dim_(x.n_rows);
+  const int m = 1;
 
-  using dblint_matrix =
-      typename std::conditional<std::is_same<U, doubles_matrix<>>::value,
-                                writable::doubles_matrix<>,
-                                writable::integers_matrix<>>::type;
+  if (std::is_same<U, doubles_matrix<>>::value) {
+    sexp y = alloc_matrix_(REALSXP, n, m);
+    std::memcpy(REAL(y), x.memptr(), x.n_elem * sizeof(double));
+    return U(y);
+  } else {
+    sexp y = alloc_matrix_(INTSXP, n, m);
+    std::memcpy(INTEGER(y), x.memptr(), x.n_elem * sizeof(int));
+    return U(y);
+  }
+}
 
-  using dblint =
-      typename std::conditional<std::is_same<U, cpp11::writable::doubles_matrix<>>::value,
-                                double, int>::type;
+inline doubles_matrix<> as_doubles_matrix(const Col<double>& x) {
+  return Col_to_dblint_matrix_<double, doubles_matrix<>>(x);
+}
 
-  dblint_matrix y(n, m);
+#if defined(CPP11ARMADILLO_USE_R_ALLOC)
+inline doubles_matrix<> as_doubles_matrix(Col<double>&& x) {
+  const int n = as_dim_(x.n_rows);
 
-  std::memcpy(y.data(), x.memptr(), n * m * sizeof(dblint));
+  sexp owner = RAllocator::take(x);
 
-  return y;
-}
+  if (owner == R_NilValue) {
+    return Col_to_dblint_matrix_<double, doubles_matrix<>>(x);
+  }
 
-inline doubles_matrix<> as_doubles_matrix(const Col<double>& x) {
-  return Col_to_dblint_matrix_<double, doubles_matrix<>>(x);
+  writable::integers dim({n, 1});
+  Rf_setAttrib(owner, R_DimSymbol, dim);
+  return doubles_matrix<>(owner);
 }
+#endif
 
 inline integers_matrix<> as_integers_matrix(const Col<int>& x) {
   return Col_to_dblint_matrix_<int, integers_matrix<>>(x);
 }
 
-// Specialization for fmat
+// Specialization for fmat, widened directly into R's memory
 inline doubles_matrix<> as_doubles_matrix(const fmat& x) {
-  Mat<double> temp = conv_to<Mat<double>>::from(x);
-  return Mat_to_dblint_matrix_<double, doubles_matrix<>>(temp);
+  sexp y = alloc_matrix_(REALSXP, x.n_rows, x.n_cols);
+  cast_copy_(x.memptr(), REAL(y), x.n_elem);
+  return doubles_matrix<>(y);
+}
+
+// fvec
+
+inline Col<float> as_fvec(const doubles& x) {
+  Col<float> y(as_uword_(x.size()), arma::fill::none);
+  cast_copy_(REAL(x.data()), y.memptr(), y.n_elem);
+  return y;
+}
+
+inline doubles as_doubles(const Col<float>& x) {
+  writable::doubles y(x.n_elem);
+  cast_copy_(x.memptr(), REAL(y), x.n_elem);
+  return y;
 }
 
 // Complex
 
+inline void Col_split_complex_(const Col<std::complex<double>>& x, double* real_data,
+                               double* imag_data) {
+  const std::complex<double>* x_data = x.memptr();
+
+  // split the real and imaginary parts in a single pass
+  for (uword i = 0; i < x.n_elem; ++i) {
+    real_data[i] = x_data[i].real();
+    imag_data[i] = x_data[i].imag();
+  }
+}
+
 inline list as_complex_doubles(const Col<std::complex<double>>& x) {
-  Col<double> x_real = real(x);
-  Col<double> x_imag = imag(x);
+  writable::doubles x_real(x.n_elem);
+  writable::doubles x_imag(x.n_elem);
 
-  return writable::list({"real"_nm = as_doubles(x_real), "imag"_nm = as_doubles(x_imag)});
+  Col_split_complex_(x, REAL(x_real), REAL(x_imag));
+
+  return writable::list({"real"_nm = x_real, "imag"_nm = x_imag});
 }
 
 inline list as_complex_matrix(const Col<std::complex<double>>& x) {
-  Col<double> x_real = real(x);
-  Col<double> x_imag = imag(x);
+  sexp x_real = alloc_matrix_(REALSXP, x.n_elem, 1);
+  sexp x_imag = alloc_matrix_(REALSXP, x.n_elem, 1);
+
+  Col_split_complex_(x, REAL(x_real), REAL(x_imag));
+
+  return writable::list({"real"_nm = x_real, "imag"_nm = x_imag});
+}
 
-  return writable::list(
-      {"real"_nm = as_doubles_matrix(x_real), "imag"_nm = as_doubles_matrix(x_imag)});
+// Complex to a native R complex vector (CPLXSXP)
+
+inline SEXP as_complexes(const Col<std::complex<double>>& x) {
+  sexp y = alloc_vector_(CPLXSXP, x.n_elem);
+
+  std::memcpy(COMPLEX(y), x.memptr(), x.n_elem * sizeof(Rcomplex));
+
+  return y;
 }
 
 #endif